@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    ProcessorLayoutBenchmark.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Cache behaviour of many plugin instances.
+
+  A session runs dozens to hundreds of reverb instances, and the host calls
+  them one after another, so by the time an instance gets its next block
+  the other instances have pushed its state out of L1/L2. What a block
+  costs then depends on how many cache lines of its state it touches.
+
+  This benchmark prepares N processors (200 by default) and calls
+  processBlock on them round-robin, the way a host does. It reports the time
+  per block and, on Linux, the L1 data cache and last-level cache read
+  misses per block from the kernel's generic perf events (there is no
+  portable L2 event; the last-level cache is the closest one). Elsewhere,
+  or where perf events are not permitted, only the time is reported.
+
+  Only processBlock is measured: the input is copied back into each buffer
+  with the clock and the counters stopped. Switching them per block adds a
+  little to every block, the same on any build.
+
+  Usage: ProcessorLayoutBenchmark [instances] [rounds] [blockSize]
+
+  Run it on builds from both sides of a layout change and compare; the
+  README shows how to build the tree before the DspState layout.
+*/
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_events/juce_events.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../Source/PluginProcessor.h"
+
+namespace {
+
+//==============================================================================
+/** One hardware cache event counted for this thread; reads -1 if the event
+ * could not be opened */
+class CacheMissCounter {
+public:
+  explicit CacheMissCounter(std::uint64_t cacheID) {
+#if defined(__linux__)
+    perf_event_attr attributes{};
+    attributes.type = PERF_TYPE_HW_CACHE;
+    attributes.size = sizeof(attributes);
+    attributes.config = cacheID | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    descriptor = static_cast<int>(
+        syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+#else
+    (void)cacheID;
+#endif
+  }
+
+  ~CacheMissCounter() {
+#if defined(__linux__)
+    if (descriptor >= 0)
+      close(descriptor);
+#endif
+  }
+
+  /** Counts on from where the last pause() left off */
+  void resume() {
+#if defined(__linux__)
+    if (descriptor >= 0)
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  void pause() {
+#if defined(__linux__)
+    if (descriptor >= 0)
+      ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+  }
+
+  /** Returns the count so far, or -1 if unavailable */
+  long long read() const {
+#if defined(__linux__)
+    if (descriptor >= 0) {
+      long long count = 0;
+      if (::read(descriptor, &count, sizeof(count)) == sizeof(count))
+        return count;
+    }
+#endif
+    return -1;
+  }
+
+private:
+  int descriptor = -1;
+};
+
+#if defined(__linux__)
+constexpr std::uint64_t l1DataCache = PERF_COUNT_HW_CACHE_L1D;
+constexpr std::uint64_t lastLevelCache = PERF_COUNT_HW_CACHE_LL;
+#else
+constexpr std::uint64_t l1DataCache = 0;
+constexpr std::uint64_t lastLevelCache = 0;
+#endif
+
+void printPerBlock(const char *name, long long count, long long numBlocks) {
+  if (count < 0)
+    std::printf("  %-22s unavailable\n", name);
+  else
+    std::printf("  %-22s %.1f\n", name,
+                static_cast<double>(count) / static_cast<double>(numBlocks));
+}
+
+int argumentOr(int argc, char **argv, int index, int fallback) {
+  return argc > index ? juce::jmax(1, std::atoi(argv[index])) : fallback;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char **argv) {
+  const int numInstances = argumentOr(argc, argv, 1, 200);
+  const int numRounds = argumentOr(argc, argv, 2, 500);
+  const int blockSize = argumentOr(argc, argv, 3, 256);
+  const double sampleRate = 48000.0;
+
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  // Every instance gets its own buffer, as it would on a host's tracks, and
+  // its own block of noise, generated once; processBlock works in place, so
+  // the noise is copied back in before every block
+  std::vector<std::unique_ptr<CustomReverbAudioProcessor>> processors;
+  std::vector<juce::AudioBuffer<float>> inputs;
+  std::vector<juce::AudioBuffer<float>> buffers;
+  juce::MidiBuffer midiBuffer;
+  juce::Random random(42);
+
+  processors.reserve(static_cast<size_t>(numInstances));
+  inputs.reserve(static_cast<size_t>(numInstances));
+  buffers.reserve(static_cast<size_t>(numInstances));
+  for (int i = 0; i < numInstances; ++i) {
+    processors.push_back(std::make_unique<CustomReverbAudioProcessor>());
+    processors.back()->prepareToPlay(sampleRate, blockSize);
+    inputs.emplace_back(2, blockSize);
+    for (int channel = 0; channel < 2; ++channel)
+      for (int sample = 0; sample < blockSize; ++sample)
+        inputs.back().setSample(channel, sample,
+                                random.nextFloat() * 0.5f - 0.25f);
+    buffers.emplace_back(2, blockSize);
+  }
+
+  CacheMissCounter l1Misses(l1DataCache);
+  CacheMissCounter lastLevelMisses(lastLevelCache);
+  double nanoseconds = 0.0;
+
+  auto runRound = [&](bool measure) {
+    for (size_t i = 0; i < processors.size(); ++i) {
+      buffers[i].makeCopyOf(inputs[i], true);
+      if (measure) {
+        l1Misses.resume();
+        lastLevelMisses.resume();
+      }
+
+      const auto blockStart = std::chrono::steady_clock::now();
+      processors[i]->processBlock(buffers[i], midiBuffer);
+      const auto blockEnd = std::chrono::steady_clock::now();
+
+      if (measure) {
+        l1Misses.pause();
+        lastLevelMisses.pause();
+        const std::chrono::duration<double, std::nano> elapsed =
+            blockEnd - blockStart;
+        nanoseconds += elapsed.count();
+      }
+    }
+  };
+
+  // Settle the parameter ramps and fault in every page before measuring
+  for (int round = 0; round < 4; ++round)
+    runRound(false);
+
+  for (int round = 0; round < numRounds; ++round)
+    runRound(true);
+
+  const long long l1Count = l1Misses.read();
+  const long long lastLevelCount = lastLevelMisses.read();
+  const long long numBlocks =
+      static_cast<long long>(numInstances) * static_cast<long long>(numRounds);
+
+  std::printf("%d instances, %d rounds, %d samples per block at %.0f Hz\n",
+              numInstances, numRounds, blockSize, sampleRate);
+  std::printf("Per processBlock call:\n");
+  std::printf("  %-22s %.0f\n", "time (ns)",
+              nanoseconds / static_cast<double>(numBlocks));
+  printPerBlock("L1D read misses", l1Count, numBlocks);
+  printPerBlock("LLC read misses", lastLevelCount, numBlocks);
+  return 0;
+}
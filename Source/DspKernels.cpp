@@ -0,0 +1,683 @@
+/*
+  ==============================================================================
+
+    DspKernels.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define REVERBWAVE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define REVERBWAVE_TARGET(isa) // MSVC accepts any intrinsic without flags
+#else
+#define REVERBWAVE_TARGET(isa) __attribute__((target(isa)))
+#endif
+#else
+#define REVERBWAVE_X86 0
+#endif
+
+namespace DspKernels {
+namespace {
+
+//==============================================================================
+// Scalar reference implementations
+
+void splitOnePoleScalar(const float *in, float *low, float *high,
+                        int numSamples, float alpha, float &state) {
+  float y = state;
+  for (int i = 0; i < numSamples; ++i) {
+    const float x = in[i];
+    y += alpha * (x - y);
+    low[i] = y;
+    high[i] = x - y;
+  }
+  state = y;
+}
+
+void crossfadeRampScalar(float *dest, const float *a, const float *b,
+                         float gain, float gainStep, int numSamples) {
+  for (int i = 0; i < numSamples; ++i)
+    dest[i] = a[i] + (b[i] - a[i]) * (gain + (float)i * gainStep);
+}
+
+void addScalar(float *dest, const float *a, const float *b, int numSamples) {
+  for (int i = 0; i < numSamples; ++i)
+    dest[i] = a[i] + b[i];
+}
+
+void fftButterflyStageScalar(float *re, float *im, const float *wr,
+                             const float *wi, int size, int halfSpan) {
+  for (int k = 0; k < size; k += 2 * halfSpan) {
+    float *r0 = re + k;
+    float *i0 = im + k;
+    float *r1 = r0 + halfSpan;
+    float *i1 = i0 + halfSpan;
+
+    for (int j = 0; j < halfSpan; ++j) {
+      const float tr = wr[j] * r1[j] - wi[j] * i1[j];
+      const float ti = wr[j] * i1[j] + wi[j] * r1[j];
+      r1[j] = r0[j] - tr;
+      i1[j] = i0[j] - ti;
+      r0[j] += tr;
+      i0[j] += ti;
+    }
+  }
+}
+
+void fillBarRowScalar(std::uint32_t *row, const std::int32_t *tops,
+                      const std::uint32_t *body, const std::uint32_t *highlight,
+                      int y, int highlightRows, int width) {
+  for (int x = 0; x < width; ++x) {
+    const std::uint32_t colour =
+        y < tops[x] + highlightRows ? highlight[x] : body[x];
+    row[x] = y < tops[x] ? 0u : colour;
+  }
+}
+
+void integrateParticlesScalar(float *x, float *y, float *vx, float *vy,
+                              float *life, int numParticles, float dt,
+                              float gravity, float drag) {
+  const float gravityStep = gravity * dt;
+  for (int i = 0; i < numParticles; ++i) {
+    vx[i] *= drag;
+    vy[i] = vy[i] * drag + gravityStep;
+    x[i] += vx[i] * dt;
+    y[i] += vy[i] * dt;
+    life[i] -= dt;
+  }
+}
+
+void waveSpringStepScalar(float *points, float *velocities,
+                          const float *targets, int numPoints, float tension,
+                          float damping, float speed, float spreadFactor) {
+  for (int i = 0; i < numPoints; ++i) {
+    velocities[i] += tension * (targets[i] - points[i]);
+    points[i] += velocities[i] * speed;
+    velocities[i] *= damping;
+  }
+
+  // Only reads points, so the velocities can be updated in place
+  for (int i = 1; i < numPoints - 1; ++i)
+    velocities[i] += spreadFactor * ((points[i - 1] - points[i]) +
+                                     (points[i + 1] - points[i]));
+}
+
+//==============================================================================
+/**
+ * The one-pole recursion y[n] = y[n-1] + alpha * (x[n] - y[n-1]) is a serial
+ * dependency chain. For a block of width samples it unrolls to
+ *   y[k] = c^(k+1) * y[-1] + sum_{j<=k} alpha * c^(k-j) * x[j],  c = 1 - alpha
+ * so the input part is a small matrix-vector product that vectorises, and
+ * only one multiply-add per block depends on the previous block.
+ */
+template <int width> struct OnePoleScan {
+  float decay[width];          // c^(k+1)
+  float input[width][width];   // input[j][k] = alpha * c^(k-j), 0 for k < j
+
+  explicit OnePoleScan(float alpha) {
+    const float c = 1.0f - alpha;
+    float power = 1.0f;
+    float powers[width + 1];
+    for (int k = 0; k <= width; ++k, power *= c)
+      powers[k] = power;
+
+    for (int k = 0; k < width; ++k) {
+      decay[k] = powers[k + 1];
+      for (int j = 0; j < width; ++j)
+        input[j][k] = k >= j ? alpha * powers[k - j] : 0.0f;
+    }
+  }
+};
+
+#if REVERBWAVE_X86
+//==============================================================================
+// SSE2
+
+REVERBWAVE_TARGET("sse2")
+void splitOnePoleSse2(const float *in, float *low, float *high, int numSamples,
+                      float alpha, float &state) {
+  const OnePoleScan<4> scan(alpha);
+  const __m128 decay = _mm_loadu_ps(scan.decay);
+  __m128 columns[4];
+  for (int j = 0; j < 4; ++j)
+    columns[j] = _mm_loadu_ps(scan.input[j]);
+
+  __m128 y = _mm_set1_ps(state);
+  int i = 0;
+  for (; i + 4 <= numSamples; i += 4) {
+    const __m128 x = _mm_loadu_ps(in + i);
+    const __m128 part0 =
+        _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(in[i])),
+                   _mm_mul_ps(columns[1], _mm_set1_ps(in[i + 1])));
+    const __m128 part1 =
+        _mm_add_ps(_mm_mul_ps(columns[2], _mm_set1_ps(in[i + 2])),
+                   _mm_mul_ps(columns[3], _mm_set1_ps(in[i + 3])));
+    const __m128 out =
+        _mm_add_ps(_mm_mul_ps(decay, y), _mm_add_ps(part0, part1));
+
+    _mm_storeu_ps(low + i, out);
+    _mm_storeu_ps(high + i, _mm_sub_ps(x, out));
+    y = _mm_shuffle_ps(out, out, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+
+  state = _mm_cvtss_f32(y);
+  splitOnePoleScalar(in + i, low + i, high + i, numSamples - i, alpha, state);
+}
+
+REVERBWAVE_TARGET("sse2")
+void crossfadeRampSse2(float *dest, const float *a, const float *b,
+                       float gain, float gainStep, int numSamples) {
+  // Gains come from the sample index, so the ramp does not drift
+  const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+  const __m128 g0 = _mm_set1_ps(gain);
+  const __m128 step = _mm_set1_ps(gainStep);
+  int i = 0;
+  for (; i + 4 <= numSamples; i += 4) {
+    const __m128 index = _mm_add_ps(_mm_set1_ps((float)i), lanes);
+    const __m128 g = _mm_add_ps(g0, _mm_mul_ps(index, step));
+    const __m128 va = _mm_loadu_ps(a + i);
+    const __m128 vb = _mm_loadu_ps(b + i);
+    _mm_storeu_ps(dest + i,
+                  _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), g)));
+  }
+  crossfadeRampScalar(dest + i, a + i, b + i, gain + (float)i * gainStep,
+                      gainStep, numSamples - i);
+}
+
+REVERBWAVE_TARGET("sse2")
+void addSse2(float *dest, const float *a, const float *b, int numSamples) {
+  int i = 0;
+  for (; i + 4 <= numSamples; i += 4)
+    _mm_storeu_ps(dest + i,
+                  _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  addScalar(dest + i, a + i, b + i, numSamples - i);
+}
+
+REVERBWAVE_TARGET("sse2")
+void fillBarRowSse2(std::uint32_t *row, const std::int32_t *tops,
+                    const std::uint32_t *body, const std::uint32_t *highlight,
+                    int y, int highlightRows, int width) {
+  // SSE2 has no blend instruction, so select with and/andnot/or
+  const __m128i vy = _mm_set1_epi32(y);
+  const __m128i vHighlightRows = _mm_set1_epi32(highlightRows);
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    const __m128i top = _mm_loadu_si128((const __m128i *)(tops + x));
+    const __m128i above = _mm_cmpgt_epi32(top, vy);
+    const __m128i inHighlight =
+        _mm_cmpgt_epi32(_mm_add_epi32(top, vHighlightRows), vy);
+    const __m128i colour = _mm_or_si128(
+        _mm_and_si128(inHighlight,
+                      _mm_loadu_si128((const __m128i *)(highlight + x))),
+        _mm_andnot_si128(inHighlight,
+                         _mm_loadu_si128((const __m128i *)(body + x))));
+    _mm_storeu_si128((__m128i *)(row + x), _mm_andnot_si128(above, colour));
+  }
+  fillBarRowScalar(row + x, tops + x, body + x, highlight + x, y,
+                   highlightRows, width - x);
+}
+
+REVERBWAVE_TARGET("sse2")
+void integrateParticlesSse2(float *x, float *y, float *vx, float *vy,
+                            float *life, int numParticles, float dt,
+                            float gravity, float drag) {
+  const __m128 vdt = _mm_set1_ps(dt);
+  const __m128 vdrag = _mm_set1_ps(drag);
+  const __m128 vgravity = _mm_set1_ps(gravity * dt);
+  int i = 0;
+  for (; i + 4 <= numParticles; i += 4) {
+    const __m128 newVx = _mm_mul_ps(_mm_loadu_ps(vx + i), vdrag);
+    const __m128 newVy =
+        _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), vdrag), vgravity);
+    _mm_storeu_ps(vx + i, newVx);
+    _mm_storeu_ps(vy + i, newVy);
+    _mm_storeu_ps(x + i,
+                  _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(newVx, vdt)));
+    _mm_storeu_ps(y + i,
+                  _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(newVy, vdt)));
+    _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), vdt));
+  }
+  integrateParticlesScalar(x + i, y + i, vx + i, vy + i, life + i,
+                           numParticles - i, dt, gravity, drag);
+}
+
+REVERBWAVE_TARGET("sse2")
+void waveSpringStepSse2(float *points, float *velocities, const float *targets,
+                        int numPoints, float tension, float damping,
+                        float speed, float spreadFactor) {
+  const __m128 vTension = _mm_set1_ps(tension);
+  const __m128 vDamping = _mm_set1_ps(damping);
+  const __m128 vSpeed = _mm_set1_ps(speed);
+  const __m128 vSpread = _mm_set1_ps(spreadFactor);
+
+  int i = 0;
+  for (; i + 4 <= numPoints; i += 4) {
+    const __m128 p = _mm_loadu_ps(points + i);
+    const __m128 v = _mm_add_ps(
+        _mm_loadu_ps(velocities + i),
+        _mm_mul_ps(vTension, _mm_sub_ps(_mm_loadu_ps(targets + i), p)));
+    _mm_storeu_ps(points + i, _mm_add_ps(p, _mm_mul_ps(v, vSpeed)));
+    _mm_storeu_ps(velocities + i, _mm_mul_ps(v, vDamping));
+  }
+  for (; i < numPoints; ++i) {
+    velocities[i] += tension * (targets[i] - points[i]);
+    points[i] += velocities[i] * speed;
+    velocities[i] *= damping;
+  }
+
+  i = 1;
+  for (; i + 4 <= numPoints - 1; i += 4) {
+    const __m128 p = _mm_loadu_ps(points + i);
+    const __m128 left = _mm_sub_ps(_mm_loadu_ps(points + i - 1), p);
+    const __m128 right = _mm_sub_ps(_mm_loadu_ps(points + i + 1), p);
+    _mm_storeu_ps(velocities + i,
+                  _mm_add_ps(_mm_loadu_ps(velocities + i),
+                             _mm_mul_ps(vSpread, _mm_add_ps(left, right))));
+  }
+  for (; i < numPoints - 1; ++i)
+    velocities[i] += spreadFactor * ((points[i - 1] - points[i]) +
+                                     (points[i + 1] - points[i]));
+}
+
+REVERBWAVE_TARGET("sse2")
+void fftButterflyStageSse2(float *re, float *im, const float *wr,
+                           const float *wi, int size, int halfSpan) {
+  if (halfSpan < 4) {
+    fftButterflyStageScalar(re, im, wr, wi, size, halfSpan);
+    return;
+  }
+
+  for (int k = 0; k < size; k += 2 * halfSpan) {
+    float *r0 = re + k;
+    float *i0 = im + k;
+    float *r1 = r0 + halfSpan;
+    float *i1 = i0 + halfSpan;
+
+    for (int j = 0; j < halfSpan; j += 4) {
+      const __m128 w_r = _mm_loadu_ps(wr + j);
+      const __m128 w_i = _mm_loadu_ps(wi + j);
+      const __m128 b_r = _mm_loadu_ps(r1 + j);
+      const __m128 b_i = _mm_loadu_ps(i1 + j);
+      const __m128 a_r = _mm_loadu_ps(r0 + j);
+      const __m128 a_i = _mm_loadu_ps(i0 + j);
+
+      const __m128 tr = _mm_sub_ps(_mm_mul_ps(w_r, b_r), _mm_mul_ps(w_i, b_i));
+      const __m128 ti = _mm_add_ps(_mm_mul_ps(w_r, b_i), _mm_mul_ps(w_i, b_r));
+
+      _mm_storeu_ps(r1 + j, _mm_sub_ps(a_r, tr));
+      _mm_storeu_ps(i1 + j, _mm_sub_ps(a_i, ti));
+      _mm_storeu_ps(r0 + j, _mm_add_ps(a_r, tr));
+      _mm_storeu_ps(i0 + j, _mm_add_ps(a_i, ti));
+    }
+  }
+}
+
+//==============================================================================
+// AVX2 (with FMA)
+
+REVERBWAVE_TARGET("avx2,fma")
+void splitOnePoleAvx2(const float *in, float *low, float *high, int numSamples,
+                      float alpha, float &state) {
+  const OnePoleScan<8> scan(alpha);
+  const __m256 decay = _mm256_loadu_ps(scan.decay);
+  __m256 columns[8];
+  for (int j = 0; j < 8; ++j)
+    columns[j] = _mm256_loadu_ps(scan.input[j]);
+
+  const __m256i lastLane = _mm256_set1_epi32(7);
+  __m256 y = _mm256_set1_ps(state);
+  int i = 0;
+  for (; i + 8 <= numSamples; i += 8) {
+    const __m256 x = _mm256_loadu_ps(in + i);
+
+    // Two independent accumulators keep the input part off the critical path
+    __m256 part0 = _mm256_mul_ps(columns[0], _mm256_broadcast_ss(in + i));
+    __m256 part1 = _mm256_mul_ps(columns[1], _mm256_broadcast_ss(in + i + 1));
+    for (int j = 2; j < 8; j += 2) {
+      part0 = _mm256_fmadd_ps(columns[j], _mm256_broadcast_ss(in + i + j),
+                              part0);
+      part1 = _mm256_fmadd_ps(columns[j + 1],
+                              _mm256_broadcast_ss(in + i + j + 1), part1);
+    }
+
+    const __m256 out = _mm256_fmadd_ps(decay, y, _mm256_add_ps(part0, part1));
+    _mm256_storeu_ps(low + i, out);
+    _mm256_storeu_ps(high + i, _mm256_sub_ps(x, out));
+    y = _mm256_permutevar8x32_ps(out, lastLane);
+  }
+
+  state = _mm256_cvtss_f32(y);
+  splitOnePoleScalar(in + i, low + i, high + i, numSamples - i, alpha, state);
+}
+
+REVERBWAVE_TARGET("avx2,fma")
+void crossfadeRampAvx2(float *dest, const float *a, const float *b,
+                       float gain, float gainStep, int numSamples) {
+  const __m256 lanes =
+      _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+  const __m256 g0 = _mm256_set1_ps(gain);
+  const __m256 step = _mm256_set1_ps(gainStep);
+  int i = 0;
+  for (; i + 8 <= numSamples; i += 8) {
+    const __m256 index = _mm256_add_ps(_mm256_set1_ps((float)i), lanes);
+    const __m256 g = _mm256_fmadd_ps(index, step, g0);
+    const __m256 va = _mm256_loadu_ps(a + i);
+    const __m256 vb = _mm256_loadu_ps(b + i);
+    _mm256_storeu_ps(dest + i,
+                     _mm256_fmadd_ps(_mm256_sub_ps(vb, va), g, va));
+  }
+  crossfadeRampScalar(dest + i, a + i, b + i, gain + (float)i * gainStep,
+                      gainStep, numSamples - i);
+}
+
+REVERBWAVE_TARGET("avx2,fma")
+void addAvx2(float *dest, const float *a, const float *b, int numSamples) {
+  int i = 0;
+  for (; i + 8 <= numSamples; i += 8)
+    _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(a + i),
+                                             _mm256_loadu_ps(b + i)));
+  addScalar(dest + i, a + i, b + i, numSamples - i);
+}
+
+REVERBWAVE_TARGET("avx2,fma")
+void fillBarRowAvx2(std::uint32_t *row, const std::int32_t *tops,
+                    const std::uint32_t *body, const std::uint32_t *highlight,
+                    int y, int highlightRows, int width) {
+  const __m256i vy = _mm256_set1_epi32(y);
+  const __m256i vHighlightRows = _mm256_set1_epi32(highlightRows);
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    const __m256i top = _mm256_loadu_si256((const __m256i *)(tops + x));
+    const __m256i above = _mm256_cmpgt_epi32(top, vy);
+    const __m256i inHighlight =
+        _mm256_cmpgt_epi32(_mm256_add_epi32(top, vHighlightRows), vy);
+    const __m256i colour = _mm256_blendv_epi8(
+        _mm256_loadu_si256((const __m256i *)(body + x)),
+        _mm256_loadu_si256((const __m256i *)(highlight + x)), inHighlight);
+    _mm256_storeu_si256((__m256i *)(row + x),
+                        _mm256_andnot_si256(above, colour));
+  }
+  fillBarRowScalar(row + x, tops + x, body + x, highlight + x, y,
+                   highlightRows, width - x);
+}
+
+REVERBWAVE_TARGET("avx2,fma")
+void integrateParticlesAvx2(float *x, float *y, float *vx, float *vy,
+                            float *life, int numParticles, float dt,
+                            float gravity, float drag) {
+  const __m256 vdt = _mm256_set1_ps(dt);
+  const __m256 vdrag = _mm256_set1_ps(drag);
+  const __m256 vgravity = _mm256_set1_ps(gravity * dt);
+  int i = 0;
+  for (; i + 8 <= numParticles; i += 8) {
+    const __m256 newVx = _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdrag);
+    const __m256 newVy =
+        _mm256_fmadd_ps(_mm256_loadu_ps(vy + i), vdrag, vgravity);
+    _mm256_storeu_ps(vx + i, newVx);
+    _mm256_storeu_ps(vy + i, newVy);
+    _mm256_storeu_ps(x + i,
+                     _mm256_fmadd_ps(newVx, vdt, _mm256_loadu_ps(x + i)));
+    _mm256_storeu_ps(y + i,
+                     _mm256_fmadd_ps(newVy, vdt, _mm256_loadu_ps(y + i)));
+    _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), vdt));
+  }
+  integrateParticlesScalar(x + i, y + i, vx + i, vy + i, life + i,
+                           numParticles - i, dt, gravity, drag);
+}
+
+REVERBWAVE_TARGET("avx2,fma")
+void waveSpringStepAvx2(float *points, float *velocities, const float *targets,
+                        int numPoints, float tension, float damping,
+                        float speed, float spreadFactor) {
+  const __m256 vTension = _mm256_set1_ps(tension);
+  const __m256 vDamping = _mm256_set1_ps(damping);
+  const __m256 vSpeed = _mm256_set1_ps(speed);
+  const __m256 vSpread = _mm256_set1_ps(spreadFactor);
+
+  int i = 0;
+  for (; i + 8 <= numPoints; i += 8) {
+    const __m256 p = _mm256_loadu_ps(points + i);
+    const __m256 pull = _mm256_sub_ps(_mm256_loadu_ps(targets + i), p);
+    const __m256 v =
+        _mm256_fmadd_ps(vTension, pull, _mm256_loadu_ps(velocities + i));
+    _mm256_storeu_ps(points + i, _mm256_fmadd_ps(v, vSpeed, p));
+    _mm256_storeu_ps(velocities + i, _mm256_mul_ps(v, vDamping));
+  }
+  for (; i < numPoints; ++i) {
+    velocities[i] += tension * (targets[i] - points[i]);
+    points[i] += velocities[i] * speed;
+    velocities[i] *= damping;
+  }
+
+  i = 1;
+  for (; i + 8 <= numPoints - 1; i += 8) {
+    const __m256 p = _mm256_loadu_ps(points + i);
+    const __m256 left = _mm256_sub_ps(_mm256_loadu_ps(points + i - 1), p);
+    const __m256 right = _mm256_sub_ps(_mm256_loadu_ps(points + i + 1), p);
+    _mm256_storeu_ps(velocities + i,
+                     _mm256_fmadd_ps(vSpread, _mm256_add_ps(left, right),
+                                     _mm256_loadu_ps(velocities + i)));
+  }
+  for (; i < numPoints - 1; ++i)
+    velocities[i] += spreadFactor * ((points[i - 1] - points[i]) +
+                                     (points[i + 1] - points[i]));
+}
+
+REVERBWAVE_TARGET("avx2,fma")
+void fftButterflyStageAvx2(float *re, float *im, const float *wr,
+                           const float *wi, int size, int halfSpan) {
+  if (halfSpan < 8) {
+    fftButterflyStageSse2(re, im, wr, wi, size, halfSpan);
+    return;
+  }
+
+  for (int k = 0; k < size; k += 2 * halfSpan) {
+    float *r0 = re + k;
+    float *i0 = im + k;
+    float *r1 = r0 + halfSpan;
+    float *i1 = i0 + halfSpan;
+
+    for (int j = 0; j < halfSpan; j += 8) {
+      const __m256 w_r = _mm256_loadu_ps(wr + j);
+      const __m256 w_i = _mm256_loadu_ps(wi + j);
+      const __m256 b_r = _mm256_loadu_ps(r1 + j);
+      const __m256 b_i = _mm256_loadu_ps(i1 + j);
+      const __m256 a_r = _mm256_loadu_ps(r0 + j);
+      const __m256 a_i = _mm256_loadu_ps(i0 + j);
+
+      const __m256 tr = _mm256_fmsub_ps(w_r, b_r, _mm256_mul_ps(w_i, b_i));
+      const __m256 ti = _mm256_fmadd_ps(w_r, b_i, _mm256_mul_ps(w_i, b_r));
+
+      _mm256_storeu_ps(r1 + j, _mm256_sub_ps(a_r, tr));
+      _mm256_storeu_ps(i1 + j, _mm256_sub_ps(a_i, ti));
+      _mm256_storeu_ps(r0 + j, _mm256_add_ps(a_r, tr));
+      _mm256_storeu_ps(i0 + j, _mm256_add_ps(a_i, ti));
+    }
+  }
+}
+
+//==============================================================================
+// AVX-512 (foundation instructions only)
+
+REVERBWAVE_TARGET("avx512f")
+void addAvx512(float *dest, const float *a, const float *b, int numSamples) {
+  int i = 0;
+  for (; i + 16 <= numSamples; i += 16)
+    _mm512_storeu_ps(dest + i, _mm512_add_ps(_mm512_loadu_ps(a + i),
+                                             _mm512_loadu_ps(b + i)));
+  addScalar(dest + i, a + i, b + i, numSamples - i);
+}
+
+REVERBWAVE_TARGET("avx512f")
+void fftButterflyStageAvx512(float *re, float *im, const float *wr,
+                             const float *wi, int size, int halfSpan) {
+  // Narrower stages go 8-wide, or further down to SSE2
+  if (halfSpan < 16) {
+    fftButterflyStageAvx2(re, im, wr, wi, size, halfSpan);
+    return;
+  }
+
+  for (int k = 0; k < size; k += 2 * halfSpan) {
+    float *r0 = re + k;
+    float *i0 = im + k;
+    float *r1 = r0 + halfSpan;
+    float *i1 = i0 + halfSpan;
+
+    for (int j = 0; j < halfSpan; j += 16) {
+      const __m512 w_r = _mm512_loadu_ps(wr + j);
+      const __m512 w_i = _mm512_loadu_ps(wi + j);
+      const __m512 b_r = _mm512_loadu_ps(r1 + j);
+      const __m512 b_i = _mm512_loadu_ps(i1 + j);
+      const __m512 a_r = _mm512_loadu_ps(r0 + j);
+      const __m512 a_i = _mm512_loadu_ps(i0 + j);
+
+      const __m512 tr = _mm512_fmsub_ps(w_r, b_r, _mm512_mul_ps(w_i, b_i));
+      const __m512 ti = _mm512_fmadd_ps(w_r, b_i, _mm512_mul_ps(w_i, b_r));
+
+      _mm512_storeu_ps(r1 + j, _mm512_sub_ps(a_r, tr));
+      _mm512_storeu_ps(i1 + j, _mm512_sub_ps(a_i, ti));
+      _mm512_storeu_ps(r0 + j, _mm512_add_ps(a_r, tr));
+      _mm512_storeu_ps(i0 + j, _mm512_add_ps(a_i, ti));
+    }
+  }
+}
+
+//==============================================================================
+// CPU feature detection
+
+struct CpuFeatures {
+  bool sse2 = false, avx2 = false, avx512 = false;
+};
+
+CpuFeatures probeCpuFeatures() {
+  CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  const int maxLeaf = info[0];
+
+  __cpuid(info, 1);
+  features.sse2 = (info[3] & (1 << 26)) != 0;
+  const bool fma = (info[2] & (1 << 12)) != 0;
+  const bool osSavesState = (info[2] & (1 << 27)) != 0;
+
+  // The OS must save the wider registers on context switches
+  const unsigned long long xcr0 = osSavesState ? _xgetbv(0) : 0;
+  const bool ymmEnabled = (xcr0 & 0x06) == 0x06;
+  const bool zmmEnabled = (xcr0 & 0xe6) == 0xe6;
+
+  if (maxLeaf >= 7) {
+    __cpuidex(info, 7, 0);
+    features.avx2 = ymmEnabled && fma && (info[1] & (1 << 5)) != 0;
+    features.avx512 = zmmEnabled && (info[1] & (1 << 16)) != 0;
+  }
+#else
+  // Also checks that the OS has enabled the register state
+  __builtin_cpu_init();
+  features.sse2 = __builtin_cpu_supports("sse2");
+  features.avx2 =
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  features.avx512 = __builtin_cpu_supports("avx512f");
+#endif
+  return features;
+}
+
+const CpuFeatures &getCpuFeatures() {
+  static const CpuFeatures features = probeCpuFeatures();
+  return features;
+}
+#endif // REVERBWAVE_X86
+
+//==============================================================================
+const KernelTable scalarKernels{InstructionSet::scalar, "Scalar",
+                                splitOnePoleScalar, crossfadeRampScalar,
+                                addScalar, fftButterflyStageScalar,
+                                fillBarRowScalar, integrateParticlesScalar,
+                                waveSpringStepScalar};
+
+#if REVERBWAVE_X86
+const KernelTable sse2Kernels{InstructionSet::sse2, "SSE2", splitOnePoleSse2,
+                              crossfadeRampSse2, addSse2,
+                              fftButterflyStageSse2, fillBarRowSse2,
+                              integrateParticlesSse2, waveSpringStepSse2};
+
+const KernelTable avx2Kernels{InstructionSet::avx2, "AVX2", splitOnePoleAvx2,
+                              crossfadeRampAvx2, addAvx2,
+                              fftButterflyStageAvx2, fillBarRowAvx2,
+                              integrateParticlesAvx2, waveSpringStepAvx2};
+
+// The block scan costs one vector multiply-add per sample at any width, so
+// 512-bit vectors only add latency per block - the AVX2 crossover is faster.
+// Bar rows, the particle pool, the wave and parameter ramps are a few hundred
+// elements long, which AVX2 already covers.
+const KernelTable avx512Kernels{InstructionSet::avx512, "AVX-512",
+                                splitOnePoleAvx2, crossfadeRampAvx2,
+                                addAvx512, fftButterflyStageAvx512,
+                                fillBarRowAvx2, integrateParticlesAvx2,
+                                waveSpringStepAvx2};
+#endif
+
+} // namespace
+
+//==============================================================================
+bool isSupported(InstructionSet instructionSet) noexcept {
+  switch (instructionSet) {
+  case InstructionSet::scalar:
+    return true;
+#if REVERBWAVE_X86
+  case InstructionSet::sse2:
+    return getCpuFeatures().sse2;
+  case InstructionSet::avx2:
+    return getCpuFeatures().avx2;
+  case InstructionSet::avx512:
+    return getCpuFeatures().avx512;
+#endif
+  default:
+    return false;
+  }
+}
+
+InstructionSet detectInstructionSet() noexcept {
+  static const InstructionSet best = [] {
+    for (auto candidate : {InstructionSet::avx512, InstructionSet::avx2,
+                           InstructionSet::sse2})
+      if (isSupported(candidate))
+        return candidate;
+    return InstructionSet::scalar;
+  }();
+  return best;
+}
+
+const KernelTable &getKernels(InstructionSet instructionSet) noexcept {
+  if (!isSupported(instructionSet))
+    return scalarKernels;
+
+  switch (instructionSet) {
+#if REVERBWAVE_X86
+  case InstructionSet::sse2:
+    return sse2Kernels;
+  case InstructionSet::avx2:
+    return avx2Kernels;
+  case InstructionSet::avx512:
+    return avx512Kernels;
+#endif
+  default:
+    return scalarKernels;
+  }
+}
+
+const KernelTable &getBestKernels() noexcept {
+  return getKernels(detectInstructionSet());
+}
+
+} // namespace DspKernels
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    DspKernels.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Runtime-dispatched implementations of the plugin's hot inner loops (audio
+  and analyzer rendering).
+
+  Every kernel has a portable scalar reference and, on x86, SSE2, AVX2 and
+  AVX-512 tables whose kernels are compiled with per-function target
+  attributes, so one binary runs everywhere without requiring those
+  instruction sets at build time. The CPU is probed once, on first use (i.e.
+  when the plugin is loaded), and callers keep a pointer to the matching
+  KernelTable - the audio thread only ever makes indirect calls, never
+  feature checks.
+
+  No JUCE dependencies - the standalone analyzer's FFT uses the same table.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+//==============================================================================
+/**
+ * DspKernels
+ *
+ * Kernel table registry. All kernels are noexcept, allocation free and safe
+ * to call from the audio thread.
+ */
+namespace DspKernels {
+
+/** Instruction sets with a kernel implementation, slowest first */
+enum class InstructionSet { scalar, sse2, avx2, avx512 };
+
+/** Function pointers for one instruction set */
+struct KernelTable {
+  InstructionSet instructionSet;
+  const char *name;
+
+  /**
+   * One-pole crossover: low = lowpass(in), high = in - low.
+   * state holds the filter's previous output and is updated. high may alias
+   * in; low must not.
+   */
+  void (*splitOnePole)(const float *in, float *low, float *high,
+                       int numSamples, float alpha, float &state);
+
+  /**
+   * Crossfade with a linear gain ramp: dest[i] = a[i] + (b[i] - a[i]) * g,
+   * g = gain + i * gainStep. Smooths a mix change over a block at the cost of
+   * a fixed gain. dest may alias a or b.
+   */
+  void (*crossfadeRamp)(float *dest, const float *a, const float *b,
+                        float gain, float gainStep, int numSamples);
+
+  /** dest[i] = a[i] + b[i]. dest may alias a or b. */
+  void (*add)(float *dest, const float *a, const float *b, int numSamples);
+
+  /**
+   * One radix-2 decimation-in-time FFT stage over split real/imaginary data:
+   * every group of 2 * halfSpan values is combined using the halfSpan
+   * twiddles wr/wi.
+   */
+  void (*fftButterflyStage)(float *re, float *im, const float *wr,
+                            const float *wi, int size, int halfSpan);
+
+  /**
+   * One image row of a bar graph, for pixel rows counted from the top:
+   * row[x] is 0 (transparent) above tops[x], highlight[x] for the first
+   * highlightRows rows of the bar and body[x] below that.
+   */
+  void (*fillBarRow)(std::uint32_t *row, const std::int32_t *tops,
+                     const std::uint32_t *body, const std::uint32_t *highlight,
+                     int y, int highlightRows, int width);
+
+  /**
+   * One semi-implicit Euler step for particles stored as separate arrays:
+   * velocities are scaled by drag (and vy gains gravity * dt), then positions
+   * move by velocity * dt and life drops by dt.
+   */
+  void (*integrateParticles)(float *x, float *y, float *vx, float *vy,
+                             float *life, int numParticles, float dt,
+                             float gravity, float drag);
+
+  /**
+   * One step of the analyzer's wave animation: every point is pulled towards
+   * its target by a damped spring (v += tension * (target - p);
+   * p += v * speed; v *= damping), then every inner point's velocity is
+   * pulled towards its neighbours by spreadFactor. Needs no scratch memory.
+   */
+  void (*waveSpringStep)(float *points, float *velocities,
+                         const float *targets, int numPoints, float tension,
+                         float damping, float speed, float spreadFactor);
+};
+
+/** Fastest instruction set supported by this CPU (detected once) */
+InstructionSet detectInstructionSet() noexcept;
+
+/** True if the kernels for an instruction set can run on this CPU */
+bool isSupported(InstructionSet instructionSet) noexcept;
+
+/** Kernel table for an instruction set. Falls back to the scalar table if
+ * the set is unsupported on this CPU or not compiled for this platform. */
+const KernelTable &getKernels(InstructionSet instructionSet) noexcept;
+
+/** Kernel table for detectInstructionSet() */
+const KernelTable &getBestKernels() noexcept;
+
+} // namespace DspKernels
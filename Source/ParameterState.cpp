@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    ParameterState.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+*/
+
+#include "ParameterState.h"
+
+#include <cstring>
+
+namespace ParameterState {
+namespace {
+
+// Fields are assembled byte by byte so chunks are portable between hosts of
+// either endianness
+void writeUint16(unsigned char *destination, std::uint16_t value) {
+  destination[0] = static_cast<unsigned char>(value);
+  destination[1] = static_cast<unsigned char>(value >> 8);
+}
+
+void writeUint32(unsigned char *destination, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    destination[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+std::uint16_t readUint16(const unsigned char *source) {
+  return static_cast<std::uint16_t>(source[0] | (source[1] << 8));
+}
+
+std::uint32_t readUint32(const unsigned char *source) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < 4; ++i)
+    value |= static_cast<std::uint32_t>(source[i]) << (8 * i);
+  return value;
+}
+
+void writeFloat(unsigned char *destination, float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeUint32(destination, bits);
+}
+
+float readFloat(const unsigned char *source) {
+  const std::uint32_t bits = readUint32(source);
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/** Size a chunk must have for the entry count and version in its header, or
+ * 0 if the version is newer than this code */
+std::size_t getRequiredSize(const unsigned char *bytes) {
+  const std::uint16_t version = readUint16(bytes + 4);
+  if (version > currentVersion)
+    return 0;
+
+  const std::size_t entriesSize = entrySize * readUint16(bytes + 6);
+  return headerSize + entriesSize + (version >= 2 ? morphPadSize : 0);
+}
+
+} // namespace
+
+//==============================================================================
+std::uint32_t hashParameterID(const char *parameterID) noexcept {
+  std::uint32_t hash = 2166136261u;
+  for (; *parameterID != '\0'; ++parameterID) {
+    hash ^= static_cast<unsigned char>(*parameterID);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool isBinaryState(const void *data, std::size_t size) noexcept {
+  return data != nullptr && size >= headerSize &&
+         readUint32(static_cast<const unsigned char *>(data)) == magic;
+}
+
+void encode(const std::uint32_t *idHashes, const float *values,
+            int numParameters, const MorphPadState &morphPad,
+            void *destination) noexcept {
+  auto *bytes = static_cast<unsigned char *>(destination);
+  writeUint32(bytes, magic);
+  writeUint16(bytes + 4, currentVersion);
+  writeUint16(bytes + 6, static_cast<std::uint16_t>(numParameters));
+
+  bytes += headerSize;
+  for (int i = 0; i < numParameters; ++i, bytes += entrySize) {
+    writeUint32(bytes, idHashes[i]);
+    writeFloat(bytes + 4, values[i]);
+  }
+
+  writeUint32(bytes, morphPad.enabled ? 1u : 0u);
+  writeFloat(bytes + 4, morphPad.x);
+  writeFloat(bytes + 8, morphPad.y);
+  std::memcpy(bytes + 12, morphPad.cornerPresets,
+              MorphPadState::numCorners);
+}
+
+int decode(const void *data, std::size_t size,
+           const std::uint32_t *idHashes, int numParameters, float *values,
+           bool *found) noexcept {
+  if (!isBinaryState(data, size))
+    return -1;
+
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  const int numEntries = readUint16(bytes + 6);
+  const std::size_t requiredSize = getRequiredSize(bytes);
+  if (requiredSize == 0 || size < requiredSize)
+    return -1;
+
+  int numFound = 0;
+  bytes += headerSize;
+  for (int entry = 0; entry < numEntries; ++entry, bytes += entrySize) {
+    const std::uint32_t hash = readUint32(bytes);
+
+    // A linear scan beats any lookup structure at a dozen parameters
+    for (int i = 0; i < numParameters; ++i) {
+      if (idHashes[i] != hash)
+        continue;
+
+      values[i] = readFloat(bytes + 4);
+      numFound += found[i] ? 0 : 1;
+      found[i] = true;
+      break;
+    }
+  }
+  return numFound;
+}
+
+bool decodeMorphPad(const void *data, std::size_t size,
+                    MorphPadState &morphPad) noexcept {
+  if (!isBinaryState(data, size))
+    return false;
+
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  const std::size_t requiredSize = getRequiredSize(bytes);
+  if (requiredSize == 0 || size < requiredSize || readUint16(bytes + 4) < 2)
+    return false;
+
+  bytes += requiredSize - morphPadSize;
+  morphPad.enabled = readUint32(bytes) != 0;
+  morphPad.x = readFloat(bytes + 4);
+  morphPad.y = readFloat(bytes + 8);
+  std::memcpy(morphPad.cornerPresets, bytes + 12, MorphPadState::numCorners);
+  return true;
+}
+
+} // namespace ParameterState
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    ParameterState.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Binary plugin state chunk.
+
+  A session stores one state chunk per plugin instance and reads all of them
+  when it opens. The chunk is a fixed layout of little-endian fields, written
+  and read with plain loads and stores - no string formatting or parsing:
+
+    offset  size  field
+    0       4     magic ("RVWS")
+    4       2     format version
+    6       2     number of entries
+    8       8n    entries: 32-bit FNV-1a hash of the parameter ID, then the
+                  parameter's plain (unnormalised) value as an IEEE float
+    8+8n    16    morph pad (version 2 on): enabled flag (32-bit), x and y
+                  as IEEE floats, then one byte per corner preset
+
+  Parameters are matched by ID hash, so adding, removing or reordering
+  parameters never breaks older chunks: unknown hashes are skipped and
+  parameters missing from a chunk keep their current value. Anything that
+  does not start with the magic number (e.g. XML written by older versions)
+  is left to the caller's fallback.
+
+  No JUCE dependencies.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * ParameterState
+ *
+ * Encoder/decoder for the binary state chunk. All functions are noexcept and
+ * allocation free.
+ */
+namespace ParameterState {
+
+/** "RVWS" as the first four bytes of a chunk */
+constexpr std::uint32_t magic = 0x53575652;
+
+/** Current format version; chunks with a newer version are rejected.
+ * Version 1 chunks hold only the parameters. */
+constexpr std::uint16_t currentVersion = 2;
+
+constexpr std::size_t headerSize = 8;
+constexpr std::size_t entrySize = 8;
+constexpr std::size_t morphPadSize = 16;
+
+/** Morph pad settings, stored after the parameters since version 2 */
+struct MorphPadState {
+  static constexpr int numCorners = 4;
+
+  bool enabled = false;
+  float x = 0.5f;
+  float y = 0.5f;
+  std::uint8_t cornerPresets[numCorners] = {};
+};
+
+/** 32-bit FNV-1a hash of a parameter ID */
+std::uint32_t hashParameterID(const char *parameterID) noexcept;
+
+/** Bytes needed to encode numParameters entries and the morph pad */
+constexpr std::size_t getEncodedSize(int numParameters) noexcept {
+  return headerSize + entrySize * static_cast<std::size_t>(numParameters) +
+         morphPadSize;
+}
+
+/** True if data starts with the chunk's magic number */
+bool isBinaryState(const void *data, std::size_t size) noexcept;
+
+/**
+ * Writes a chunk of (idHashes[i], values[i]) entries and the morph pad into
+ * destination, which must hold getEncodedSize(numParameters) bytes.
+ */
+void encode(const std::uint32_t *idHashes, const float *values,
+            int numParameters, const MorphPadState &morphPad,
+            void *destination) noexcept;
+
+/**
+ * Reads a chunk. For every entry whose hash is idHashes[i], values[i] is set
+ * and found[i] becomes true; other values are left untouched.
+ * @return number of parameters found, or -1 if the chunk is not a binary
+ *         state, was written by a newer version or is truncated (values are
+ *         then untouched)
+ */
+int decode(const void *data, std::size_t size,
+           const std::uint32_t *idHashes, int numParameters, float *values,
+           bool *found) noexcept;
+
+/**
+ * Reads the morph pad of a chunk into morphPad.
+ * @return false (morphPad untouched) if decode() would reject the chunk or
+ *         it predates the morph pad
+ */
+bool decodeMorphPad(const void *data, std::size_t size,
+                    MorphPadState &morphPad) noexcept;
+
+} // namespace ParameterState
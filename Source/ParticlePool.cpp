@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    ParticlePool.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+*/
+
+#include "ParticlePool.h"
+
+//==============================================================================
+ParticlePool::ParticlePool(int capacityToUse)
+    : capacity(capacityToUse > 0 ? capacityToUse : 1) {
+  const auto size = static_cast<std::size_t>(capacity);
+  x.resize(size);
+  y.resize(size);
+  vx.resize(size);
+  vy.resize(size);
+  life.resize(size);
+  tags.resize(size);
+}
+
+bool ParticlePool::spawn(float newX, float newY, float newVx, float newVy,
+                         float newLife, std::uint16_t tag) noexcept {
+  if (isFull())
+    return false;
+
+  const int i = numAlive++;
+  x[i] = newX;
+  y[i] = newY;
+  vx[i] = newVx;
+  vy[i] = newVy;
+  life[i] = newLife;
+  tags[i] = tag;
+  return true;
+}
+
+void ParticlePool::step(float dt, float gravity, float drag) noexcept {
+  kernels->integrateParticles(x.data(), y.data(), vx.data(), vy.data(),
+                              life.data(), numAlive, dt, gravity, drag);
+
+  // Swap-remove: order does not matter for drawing, and the live particles
+  // stay contiguous for the next integration step
+  for (int i = 0; i < numAlive;) {
+    if (life[i] > 0.0f) {
+      ++i;
+      continue;
+    }
+
+    const int last = --numAlive;
+    x[i] = x[last];
+    y[i] = y[last];
+    vx[i] = vx[last];
+    vy[i] = vy[last];
+    life[i] = life[last];
+    tags[i] = tags[last];
+  }
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ParticlePool.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Fixed-capacity particle storage for the analyzer's Particles mode.
+
+  Each attribute lives in its own array (structure of arrays), so one
+  integration step is a single pass of the SIMD particle kernel over
+  contiguous floats. The pool never allocates after construction. Spawning
+  into a full pool is rejected, and a dead particle is replaced by the last
+  live one, so the live particles always occupy [0, size()) and the cost of a
+  frame is bounded by the capacity, whatever the spectrum looks like.
+
+  No JUCE dependencies.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "DspKernels.h"
+
+//==============================================================================
+/**
+ * XorShiftRandom
+ *
+ * Marsaglia's xorshift32: three shifts per number, deterministic for a given
+ * seed. Good enough for visual jitter, not for anything statistical.
+ */
+class XorShiftRandom {
+public:
+  explicit XorShiftRandom(std::uint32_t seed = 0x9e3779b9u) noexcept
+      : state(seed != 0 ? seed : 0x9e3779b9u) {}
+
+  std::uint32_t next() noexcept {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  /** Uniform in [0, 1) */
+  float nextFloat() noexcept {
+    return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+  }
+
+private:
+  std::uint32_t state; // Never zero
+};
+
+//==============================================================================
+/**
+ * ParticlePool
+ *
+ * Live particles with position, velocity, remaining life and a caller-defined
+ * tag (e.g. which sprite to draw). Units are up to the caller.
+ */
+class ParticlePool {
+public:
+  /** Allocates storage for capacity particles */
+  explicit ParticlePool(int capacity);
+
+  int getCapacity() const noexcept { return capacity; }
+  int size() const noexcept { return numAlive; }
+  bool isFull() const noexcept { return numAlive == capacity; }
+
+  /**
+   * Adds a particle if there is room.
+   * @return false if the pool is full
+   */
+  bool spawn(float x, float y, float vx, float vy, float life,
+             std::uint16_t tag) noexcept;
+
+  /** Integrates every live particle by dt (see
+   * DspKernels::KernelTable::integrateParticles) and removes those whose life
+   * has run out */
+  void step(float dt, float gravity, float drag) noexcept;
+
+  /** Removes all particles */
+  void clear() noexcept { numAlive = 0; }
+
+  /** Attribute arrays of the live particles, size() elements each */
+  const float *getX() const noexcept { return x.data(); }
+  const float *getY() const noexcept { return y.data(); }
+  const float *getLife() const noexcept { return life.data(); }
+  const std::uint16_t *getTags() const noexcept { return tags.data(); }
+
+private:
+  int capacity;
+  int numAlive = 0;
+
+  std::vector<float> x, y, vx, vy, life;
+  std::vector<std::uint16_t> tags;
+
+  const DspKernels::KernelTable *kernels = &DspKernels::getBestKernels();
+};
@@ -18,6 +18,7 @@
      - Main plugin interface with interactive controls
      - Parameter sliders with custom styling and tooltips
      - Preset management system for quick parameter recall
+     - XY pad for live morphing between presets
      - Integration with the SpectrumAnalyzer for visual feedback
 
   The implementation connects UI controls to the AudioProcessorValueTreeState
@@ -28,6 +29,76 @@
 #include "PluginEditor.h"
 #include "PluginProcessor.h"
 
+namespace {
+// Renders a static layer once at the display's physical resolution, so
+// repaints only have to blit it
+template <typename PaintFunction>
+juce::Image renderCachedLayer(int width, int height, float scale,
+                              const juce::ImageType &type,
+                              PaintFunction &&paintLayer) {
+  juce::Image image(juce::Image::ARGB,
+                    juce::jmax(1, juce::roundToInt((float)width * scale)),
+                    juce::jmax(1, juce::roundToInt((float)height * scale)),
+                    true, type);
+  juce::Graphics g(image);
+  g.addTransform(juce::AffineTransform::scale(scale));
+  paintLayer(g);
+  return image;
+}
+
+// Appends the polyline through levels (0-1, 0 at the bottom) to path, spread
+// evenly over width. With more levels than device pixel columns, each column
+// contributes only the lowest and highest level of its bands, in the order
+// they occur, so the vertex count follows the on-screen width and peaks
+// survive. Starts a new sub-path unless continuePath is set.
+void addLevelsToPath(juce::Path &path, const float *levels, int numLevels,
+                     float width, float height, float scale,
+                     bool continuePath) {
+  auto addVertex = [&](float x, float level) {
+    const float y = height * (1.0f - level);
+    if (continuePath)
+      path.lineTo(x, y);
+    else
+      path.startNewSubPath(x, y);
+    continuePath = true;
+  };
+
+  const int numColumns = juce::jmax(2, juce::roundToInt(width * scale));
+  if (numLevels <= numColumns) {
+    for (int i = 0; i < numLevels; ++i)
+      addVertex(width * i / static_cast<float>(numLevels - 1), levels[i]);
+    return;
+  }
+
+  for (int column = 0; column < numColumns; ++column) {
+    const int first = column * numLevels / numColumns;
+    const int end = (column + 1) * numLevels / numColumns;
+
+    int lowest = first, highest = first;
+    for (int i = first + 1; i < end; ++i) {
+      if (levels[i] < levels[lowest])
+        lowest = i;
+      if (levels[i] > levels[highest])
+        highest = i;
+    }
+
+    const float x = width * column / static_cast<float>(numColumns - 1);
+    addVertex(x, levels[juce::jmin(lowest, highest)]);
+    if (lowest != highest)
+      addVertex(x, levels[juce::jmax(lowest, highest)]);
+  }
+}
+
+// Draws a layer rendered by renderCachedLayer at its logical size
+void drawCachedLayer(juce::Graphics &g, const juce::Image &image,
+                     float scale) {
+  if (scale == 1.0f)
+    g.drawImageAt(image, 0, 0);
+  else
+    g.drawImageTransformed(image, juce::AffineTransform::scale(1.0f / scale));
+}
+} // namespace
+
 //==============================================================================
 // SpectrumAnalyzerComponent Implementation
 //==============================================================================
@@ -35,7 +106,7 @@
 SpectrumAnalyzerComponent::SpectrumAnalyzerComponent(
     CustomReverbAudioProcessor &processor)
     : processorRef(processor), fft(processor.fftOrder),
-      fftSize(1 << processor.fftOrder) {
+      fftSize(1 << processor.fftOrder), wavePhysics(processor.scopeSize) {
   // Set up the FFT data array
   fftData.allocate(2 * fftSize, true);
 
@@ -43,66 +114,91 @@ SpectrumAnalyzerComponent::SpectrumAnalyzerComponent(
   spectrumValues.resize(processor.scopeSize, 0.0f);
   previousSpectrumValues.resize(processor.scopeSize, 0.0f);
   targetSpectrumValues.resize(processor.scopeSize, 0.0f);
-
-  // Initialize wave animation data
-  wavePoints.resize(processor.scopeSize, 0.0f);
-  waveVelocities.resize(processor.scopeSize, 0.0f);
-  waveTargets.resize(processor.scopeSize, 0.0f);
-
-  // Register this component with the processor
-  processor.setSpectrumAnalyzer(this);
-
-  // Start the animation timer
-  startTimerHz(60); // 60fps for smooth animation
+  inputSpectrumValues.resize(processor.scopeSize, 0.0f);
+  inputTargetValues.resize(processor.scopeSize, 0.0f);
+
+  // Preallocate the spectrogram history so frames never allocate
+  spectrogramImage = juce::Image(juce::Image::ARGB, spectrogramHistory,
+                                 processor.scopeSize, true);
+  rebuildSpectrogramPalette();
+  rebuildBarPalette();
+  rebuildParticleSprites();
+
+  // Scratch for comparing new snapshots against the current ones
+  latestFrame.resize(processor.scopeSize, 0.0f);
+  latestInputFrame.resize(processor.scopeSize, 0.0f);
+
+  // Every pixel is painted, so repaints never reach the editor behind us
+  setOpaque(true);
+
+  // Refresh in step with the display. The attachment follows us between
+  // windows and only fires while we are on one; the analysis is started by
+  // the first VBlank on screen.
+  vBlankAttachment = std::make_unique<juce::VBlankAttachment>(
+      this, [this](double timestampSec) { onVBlank(timestampSec); });
 }
 
 SpectrumAnalyzerComponent::~SpectrumAnalyzerComponent() {
-  // Unregister from processor
-  processorRef.setSpectrumAnalyzer(nullptr);
-  stopTimer();
+  setBackgroundRendering(false);
+  vBlankAttachment.reset();
+
+  // Nothing else will pull frames, so stop the analysis thread
+  processorRef.setSpectrumAnalyzerActive(false);
 }
 
 void SpectrumAnalyzerComponent::paint(juce::Graphics &g) {
-  const auto width = static_cast<float>(getWidth());
-  const auto height = static_cast<float>(getHeight());
-
-  // Draw background
-  g.fillAll(juce::Colour(10, 15, 20));
+  const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
 
-  // Draw grid lines
-  g.setColour(juce::Colour(40, 45, 50));
-  for (int i = 1; i < 10; ++i) {
-    auto y = height * i / 10.0f;
-    g.drawLine(0, y, width, y, 0.5f);
+  if (renderThread == nullptr) {
+    frameBounds = getLocalBounds();
+    renderFrame(g, scale);
+    return;
   }
 
-  for (int i = 1; i < 10; ++i) {
-    auto x = width * i / 10.0f;
-    g.drawLine(x, 0, x, height, 0.5f);
+  // Background rendering: the newest finished frame is all there is to draw
+  lastPaintScale = scale;
+  const int front = frontFrame.load(std::memory_order_acquire);
+  if (front < 0) {
+    g.fillAll(juce::Colour(10, 15, 20));
+    requestRefresh();
+    return;
   }
 
-  // Draw frequency labels
-  g.setColour(juce::Colours::grey);
-  g.setFont(12.0f);
+  const auto &frame = renderedFrames[front];
+  drawCachedLayer(g, frame, renderedFrameScales[front]);
 
-  auto sampleRate = processorRef.getSampleRate();
-  if (sampleRate > 0) {
-    const char *freqLabels[] = {"20", "50", "100", "200", "500",
-                                "1k", "2k", "5k",  "10k", "20k"};
-    const float freqValues[] = {20.0f,   50.0f,   100.0f,  200.0f,   500.0f,
-                                1000.0f, 2000.0f, 5000.0f, 10000.0f, 20000.0f};
-
-    for (int i = 0; i < 10; ++i) {
-      auto freq = freqValues[i];
-      auto normX = std::log10(freq / 20.0f) / std::log10(20000.0f / 20.0f);
-      auto x = width * normX;
+  // Rendered at another size or scale: draw a matching one next
+  if (renderedFrameScales[front] != scale ||
+      frame.getWidth() !=
+          juce::jmax(1, juce::roundToInt((float)getWidth() * scale)) ||
+      frame.getHeight() !=
+          juce::jmax(1, juce::roundToInt((float)getHeight() * scale)))
+    requestRefresh();
+}
 
-      if (x >= 0 && x < width) {
-        g.drawText(freqLabels[i], static_cast<int>(x) - 10, (int)height - 20,
-                   20, 20, juce::Justification::centred);
-        g.drawLine(x, height - 22, x, height - 18, 1.0f);
-      }
+void SpectrumAnalyzerComponent::renderFrame(juce::Graphics &g, float scale) {
+  const auto width = static_cast<float>(frameBounds.getWidth());
+  const auto height = static_cast<float>(frameBounds.getHeight());
+
+  // The spectrogram is opaque and has its own axis; every other mode draws
+  // over the cached background, grid and labels
+  if (animationMode == 3) {
+    drawSpectrogram(g);
+  } else {
+    const bool hasLabels = processorRef.getSampleRate() > 0;
+    if (!staticLayer.isValid() || staticLayerScale != scale ||
+        staticLayerHasLabels != hasLabels) {
+      staticLayer = renderCachedLayer(
+          frameBounds.getWidth(), frameBounds.getHeight(), scale,
+          getLayerImageType(), [&](juce::Graphics &layer) {
+            layer.fillAll(juce::Colour(10, 15, 20));
+            drawGridAndLabels(layer, width, height);
+          });
+      staticLayerScale = scale;
+      staticLayerHasLabels = hasLabels;
     }
+
+    drawCachedLayer(g, staticLayer, staticLayerScale);
   }
 
   // Draw the fluid wave animation based on spectrum data
@@ -121,21 +217,14 @@ void SpectrumAnalyzerComponent::paint(juce::Graphics &g) {
 
     g.setGradientFill(gradient);
 
-    // Create a path for the wave
-    juce::Path wavePath;
-    wavePath.startNewSubPath(0, height);
-
-    for (int i = 0; i < spectrumValues.size(); ++i) {
-      float x = width * i / static_cast<float>(spectrumValues.size() - 1);
-      float y = height * (1.0f - wavePoints[i]);
-
-      if (i == 0)
-        wavePath.startNewSubPath(x, y);
-      else
-        wavePath.lineTo(x, y);
-    }
+    const float *wavePoints = wavePhysics.getPoints();
+    const int numPoints = wavePhysics.getNumPoints();
 
-    // Complete the wave path
+    // The wave area, at most two vertices per device pixel column
+    wavePath.clear();
+    wavePath.startNewSubPath(0, height);
+    addLevelsToPath(wavePath, wavePoints, numPoints, width, height, scale,
+                    true);
     wavePath.lineTo(width, height);
     wavePath.closeSubPath();
 
@@ -149,8 +238,8 @@ void SpectrumAnalyzerComponent::paint(juce::Graphics &g) {
     // Add some particle effects for extra flair
     g.setColour(baseColour2.brighter(0.5f));
     for (int i = 0; i < 20; ++i) {
-      int idx = random.nextInt((int)wavePoints.size());
-      float x = width * idx / static_cast<float>(wavePoints.size() - 1);
+      int idx = random.nextInt(numPoints);
+      float x = width * idx / static_cast<float>(numPoints - 1);
       float y = height * (1.0f - wavePoints[idx]);
       float size = 1.0f + 2.0f * wavePoints[idx];
 
@@ -158,149 +247,605 @@ void SpectrumAnalyzerComponent::paint(juce::Graphics &g) {
     }
   } else if (animationMode == 1) // Bar mode
   {
-    // Draw frequency spectrum as animated bars
-    const int numBars = (int)spectrumValues.size();
-    const float barWidth = width / static_cast<float>(numBars);
+    // Bars are rendered straight into pixels, one column per device pixel
+    renderBars(scale);
+    drawCachedLayer(g, barsImage, scale);
+  } else if (animationMode == 2) // Particle mode
+  {
+    drawParticles(g);
+  }
+
+  // The overlay shares the frequency axis, which the spectrogram does not
+  if (showInput && animationMode != 3)
+    drawInputOverlay(g, scale);
+
+  drawCorrelationMeter(g);
+
+  // Draw frequency analyzer frame
+  g.setColour(juce::Colours::white.withAlpha(0.3f));
+  g.drawRect(frameBounds, 1);
+}
+
+void SpectrumAnalyzerComponent::drawGridAndLabels(juce::Graphics &g,
+                                                  float width, float height) {
+  // Draw grid lines
+  g.setColour(juce::Colour(40, 45, 50));
+  for (int i = 1; i < 10; ++i) {
+    auto y = height * i / 10.0f;
+    g.drawLine(0, y, width, y, 0.5f);
+  }
 
-    for (int i = 0; i < numBars; ++i) {
-      float barHeight = wavePoints[i] * height;
+  for (int i = 1; i < 10; ++i) {
+    auto x = width * i / 10.0f;
+    g.drawLine(x, 0, x, height, 0.5f);
+  }
 
-      // Create color gradient based on frequency and amplitude
-      float intensity = 0.4f + 0.6f * wavePoints[i];
-      float hue = colorScheme == 0 ? 0.6f - 0.2f * wavePoints[i]
-                                   : // Blue scheme
-                      colorScheme == 1 ? 0.8f - 0.2f * wavePoints[i]
-                                       :           // Purple scheme
-                      0.3f - 0.2f * wavePoints[i]; // Green scheme
+  // Draw frequency labels
+  g.setColour(juce::Colours::grey);
+  g.setFont(12.0f);
 
-      juce::Colour barColor = juce::Colour::fromHSV(hue, 0.7f, intensity, 1.0f);
+  auto sampleRate = processorRef.getSampleRate();
+  if (sampleRate > 0) {
+    const char *freqLabels[] = {"20", "50", "100", "200", "500",
+                                "1k", "2k", "5k",  "10k", "20k"};
+    const float freqValues[] = {20.0f,   50.0f,   100.0f,  200.0f,   500.0f,
+                                1000.0f, 2000.0f, 5000.0f, 10000.0f, 20000.0f};
 
-      g.setColour(barColor);
-      g.fillRect(i * barWidth, height - barHeight, barWidth, barHeight);
+    for (int i = 0; i < 10; ++i) {
+      auto freq = freqValues[i];
+      auto normX = std::log10(freq / 20.0f) / std::log10(20000.0f / 20.0f);
+      auto x = width * normX;
 
-      // Add highlight effect at the top of the bar
-      g.setColour(barColor.brighter(0.5f));
-      g.fillRect(i * barWidth, height - barHeight, barWidth, 2.0f);
-    }
-  } else if (animationMode == 2) // Particle mode
-  {
-    // Draw frequency spectrum as animated particles
-    const int numBars = (int)spectrumValues.size();
-    const float barWidth = width / static_cast<float>(numBars);
-
-    for (int i = 0; i < numBars; ++i) {
-      float level = wavePoints[i];
-
-      // Only draw particles for frequencies with some energy
-      if (level > 0.05f) {
-        // Number of particles depends on frequency energy
-        int numParticles = static_cast<int>(level * 10.0f);
-
-        for (int j = 0; j < numParticles; ++j) {
-          float particleSize =
-              (1.0f + 4.0f * level) * (0.5f + 0.5f * random.nextFloat());
-
-          // Particle position: x based on frequency, y based on amplitude with
-          // randomness
-          float x = i * barWidth + random.nextFloat() * barWidth;
-          float y =
-              height - height * level * (0.5f + 0.5f * random.nextFloat());
-
-          // Color based on frequency and scheme
-          float hue =
-              colorScheme == 0 ? 0.6f - 0.2f * (static_cast<float>(i) / numBars)
-                               : // Blue scheme
-                  colorScheme == 1
-                  ? 0.8f - 0.3f * (static_cast<float>(i) / numBars)
-                  : // Purple scheme
-                  0.3f -
-                      0.2f * (static_cast<float>(i) / numBars); // Green scheme
-
-          juce::Colour particleColor =
-              juce::Colour::fromHSV(hue, 0.8f, 0.9f, 0.7f);
-
-          g.setColour(particleColor);
-          g.fillEllipse(x - particleSize / 2, y - particleSize / 2,
-                        particleSize, particleSize);
-        }
+      if (x >= 0 && x < width) {
+        g.drawText(freqLabels[i], static_cast<int>(x) - 10, (int)height - 20,
+                   20, 20, juce::Justification::centred);
+        g.drawLine(x, height - 22, x, height - 18, 1.0f);
       }
     }
   }
+}
 
-  // Draw frequency analyzer frame
-  g.setColour(juce::Colours::white.withAlpha(0.3f));
-  g.drawRect(getLocalBounds(), 1);
+void SpectrumAnalyzerComponent::drawCorrelationMeter(juce::Graphics &g) {
+  // Horizontal -1..+1 scale with the bar growing from the centre
+  const auto meter = juce::Rectangle<float>(
+      (float)frameBounds.getWidth() - 130.0f, 8.0f, 120.0f, 6.0f);
+
+  g.setColour(juce::Colour(40, 45, 50));
+  g.fillRect(meter);
+
+  const float centreX = meter.getCentreX();
+  const float valueX = centreX + 0.5f * meter.getWidth() *
+                                     juce::jlimit(-1.0f, 1.0f, correlation);
+  g.setColour(correlation >= 0.0f ? juce::Colours::limegreen
+                                  : juce::Colours::orangered);
+  g.fillRect(juce::Rectangle<float>(juce::jmin(centreX, valueX), meter.getY(),
+                                    std::abs(valueX - centreX),
+                                    meter.getHeight()));
+
+  g.setColour(juce::Colours::grey);
+  g.drawLine(centreX, meter.getY() - 2.0f, centreX, meter.getBottom() + 2.0f,
+             1.0f);
+  const auto label = meter.withWidth(14.0f).expanded(0.0f, 4.0f);
+  g.drawText("-1", label.withX(meter.getX() - 16.0f),
+             juce::Justification::centredRight);
+  g.drawText("+1", label.withX(meter.getRight() + 2.0f),
+             juce::Justification::centredLeft);
+}
+
+void SpectrumAnalyzerComponent::drawInputOverlay(juce::Graphics &g,
+                                                 float scale) {
+  const auto width = static_cast<float>(frameBounds.getWidth());
+  const auto height = static_cast<float>(frameBounds.getHeight());
+
+  inputPath.clear();
+  addLevelsToPath(inputPath, inputSpectrumValues.data(),
+                  (int)inputSpectrumValues.size(), width, height, scale,
+                  false);
+
+  g.setColour(juce::Colours::white.withAlpha(0.6f));
+  g.strokePath(inputPath, juce::PathStrokeType(1.0f));
+}
+
+void SpectrumAnalyzerComponent::writeSpectrogramColumn(
+    const std::vector<float> &levels) {
+  const int numRows = spectrogramImage.getHeight();
+
+  // Only the new column is touched; band 0 (20Hz) goes to the bottom row
+  juce::Image::BitmapData bitmap(spectrogramImage, spectrogramWriteColumn, 0,
+                                 1, numRows,
+                                 juce::Image::BitmapData::writeOnly);
+
+  for (int row = 0; row < numRows; ++row) {
+    const float level = juce::jlimit(0.0f, 1.0f, levels[numRows - 1 - row]);
+    auto *pixel = reinterpret_cast<juce::PixelARGB *>(
+        bitmap.getLinePointer(row));
+    pixel->set(spectrogramPalette[(int)(level * 255.0f)]);
+  }
+
+  spectrogramWriteColumn = (spectrogramWriteColumn + 1) % spectrogramHistory;
+}
+
+void SpectrumAnalyzerComponent::drawSpectrogram(juce::Graphics &g) {
+  // The oldest column sits at the write position, so the history is the
+  // image from there to its end followed by its start: two blits, whatever
+  // the history length
+  const int width = frameBounds.getWidth();
+  const int height = frameBounds.getHeight();
+  const int numRows = spectrogramImage.getHeight();
+  const int numOlder = spectrogramHistory - spectrogramWriteColumn;
+  const int splitX = width * numOlder / spectrogramHistory;
+
+  g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+  g.drawImage(spectrogramImage, 0, 0, splitX, height, spectrogramWriteColumn,
+              0, numOlder, numRows);
+
+  if (spectrogramWriteColumn > 0)
+    g.drawImage(spectrogramImage, splitX, 0, width - splitX, height, 0, 0,
+                spectrogramWriteColumn, numRows);
+}
+
+void SpectrumAnalyzerComponent::renderBars(float scale) {
+  const int width =
+      juce::jmax(1, juce::roundToInt((float)frameBounds.getWidth() * scale));
+  const int height =
+      juce::jmax(1, juce::roundToInt((float)frameBounds.getHeight() * scale));
+
+  // Only reallocates when the size changes
+  if (barsImage.getWidth() != width || barsImage.getHeight() != height) {
+    barsImage = juce::Image(juce::Image::ARGB, width, height, true,
+                            getLayerImageType());
+    barTops.resize((size_t)width);
+    barBody.resize((size_t)width);
+    barHighlight.resize((size_t)width);
+  }
+
+  // Max-pool the bands that fall into each pixel column (or repeat the
+  // nearest band when there are more columns than bands), so narrow bars
+  // never overdraw and peaks never disappear
+  const float *wavePoints = wavePhysics.getPoints();
+  const int numBands = wavePhysics.getNumPoints();
+  for (int x = 0; x < width; ++x) {
+    const int firstBand = x * numBands / width;
+    const int endBand = juce::jmax(firstBand + 1, (x + 1) * numBands / width);
+
+    float level = 0.0f;
+    for (int band = firstBand; band < endBand; ++band)
+      level = juce::jmax(level, wavePoints[band]);
+    level = juce::jlimit(0.0f, 1.0f, level);
+
+    const int index = (int)(level * 255.0f);
+    barTops[x] = height - juce::roundToInt(level * (float)height);
+    barBody[x] = barBodyPalette[index];
+    barHighlight[x] = barHighlightPalette[index];
+  }
+
+  // Fill whole rows with the SIMD kernel; the 2px highlight scales with the
+  // display
+  const int highlightRows = juce::jmax(1, juce::roundToInt(2.0f * scale));
+  juce::Image::BitmapData bitmap(barsImage,
+                                 juce::Image::BitmapData::writeOnly);
+  for (int y = 0; y < height; ++y) {
+    auto *row = reinterpret_cast<std::uint32_t *>(bitmap.getLinePointer(y));
+    kernels->fillBarRow(row, barTops.data(), barBody.data(),
+                        barHighlight.data(), y, highlightRows, width);
+  }
+}
+
+void SpectrumAnalyzerComponent::rebuildBarPalette() {
+  // Hue and brightness follow the level, as the bars always did
+  const float baseHue =
+      colorScheme == 0 ? 0.6f : (colorScheme == 1 ? 0.8f : 0.3f);
+
+  for (int i = 0; i < 256; ++i) {
+    const float level = i / 255.0f;
+    const auto colour = juce::Colour::fromHSV(baseHue - 0.2f * level, 0.7f,
+                                              0.4f + 0.6f * level, 1.0f);
+    barBodyPalette[i] = colour.getPixelARGB().getNativeARGB();
+    barHighlightPalette[i] =
+        colour.brighter(0.5f).getPixelARGB().getNativeARGB();
+  }
+}
+
+void SpectrumAnalyzerComponent::updateParticles(float deltaTime) {
+  // Spawn where the spectrum has energy: try a fixed number of random bands
+  // and keep each with a probability equal to its level, so busy spectra
+  // never spawn more than maxSpawnsPerFrame particles per frame
+  const float *wavePoints = wavePhysics.getPoints();
+  const int numBands = wavePhysics.getNumPoints();
+  for (int attempt = 0; attempt < maxSpawnsPerFrame && !particles.isFull();
+       ++attempt) {
+    const int band = juce::jmin(
+        numBands - 1, (int)(particleRandom.nextFloat() * (float)numBands));
+    const float level = juce::jlimit(0.0f, 1.0f, wavePoints[band]);
+    if (level <= 0.05f || particleRandom.nextFloat() > level)
+      continue;
+
+    // Positions are normalised to the component (y grows downwards)
+    const float x = (band + particleRandom.nextFloat()) / (float)numBands;
+    const float y = 1.0f - level * (0.5f + 0.5f * particleRandom.nextFloat());
+    const float vx = 0.05f * (particleRandom.nextFloat() - 0.5f);
+    const float vy = -0.4f * level * particleRandom.nextFloat();
+    const float life = 0.3f + 0.5f * particleRandom.nextFloat();
+
+    const int hue = juce::jmin(particleHues - 1, (int)(x * particleHues));
+    const int size =
+        juce::jmin(particleSizes - 1, (int)(level * particleSizes));
+    particles.spawn(x, y, vx, vy, life,
+                    (std::uint16_t)(hue * particleSizes + size));
+  }
+
+  particles.step(deltaTime, particleGravity, particleDrag);
+}
+
+void SpectrumAnalyzerComponent::drawParticles(juce::Graphics &g) {
+  // Unscaled sub-image blits from the sprite sheet: no path rasterisation
+  // and no colour changes per particle
+  const float width = (float)frameBounds.getWidth();
+  const float height = (float)frameBounds.getHeight();
+  const int halfCell = particleCellSize / 2;
+
+  const float *x = particles.getX();
+  const float *y = particles.getY();
+  const std::uint16_t *tags = particles.getTags();
+
+  for (int i = 0; i < particles.size(); ++i) {
+    const int hue = tags[i] / particleSizes;
+    const int size = tags[i] % particleSizes;
+    g.drawImage(particleSprites, juce::roundToInt(x[i] * width) - halfCell,
+                juce::roundToInt(y[i] * height) - halfCell, particleCellSize,
+                particleCellSize, hue * particleCellSize,
+                size * particleCellSize, particleCellSize, particleCellSize);
+  }
+}
+
+void SpectrumAnalyzerComponent::rebuildParticleSprites() {
+  // One cell per hue bucket (columns) and size (rows), hues following the
+  // colour scheme across the frequency axis
+  particleSprites =
+      juce::Image(juce::Image::ARGB, particleHues * particleCellSize,
+                  particleSizes * particleCellSize, true, getLayerImageType());
+  juce::Graphics g(particleSprites);
+
+  const float baseHue =
+      colorScheme == 0 ? 0.6f : (colorScheme == 1 ? 0.8f : 0.3f);
+  const float hueSpan = colorScheme == 1 ? 0.3f : 0.2f;
+
+  for (int hue = 0; hue < particleHues; ++hue) {
+    const float position = (hue + 0.5f) / (float)particleHues;
+    g.setColour(juce::Colour::fromHSV(baseHue - hueSpan * position, 0.8f,
+                                      0.9f, 0.7f));
+
+    for (int size = 0; size < particleSizes; ++size) {
+      const float diameter = 2.0f + (float)size;
+      const auto cell = juce::Rectangle<float>(
+          (float)(hue * particleCellSize), (float)(size * particleCellSize),
+          (float)particleCellSize, (float)particleCellSize);
+      g.fillEllipse(cell.withSizeKeepingCentre(diameter, diameter));
+    }
+  }
+}
+
+void SpectrumAnalyzerComponent::rebuildSpectrogramPalette() {
+  // Silence is black, rising through the scheme's two colours to white
+  for (int i = 0; i < 256; ++i) {
+    const float level = i / 255.0f;
+    juce::Colour colour;
+
+    if (level < 0.4f)
+      colour = juce::Colours::black.interpolatedWith(baseColour1, level / 0.4f);
+    else if (level < 0.8f)
+      colour = baseColour1.interpolatedWith(baseColour2, (level - 0.4f) / 0.4f);
+    else
+      colour = baseColour2.interpolatedWith(juce::Colours::white,
+                                            (level - 0.8f) / 0.2f);
+
+    spectrogramPalette[i] = colour.getPixelARGB();
+  }
 }
 
 void SpectrumAnalyzerComponent::resized() {
-  // Nothing to do here as sizing is handled by the parent component
+  // The cached background is rebuilt at the new size on the next frame
+  finishPendingFrame();
+  staticLayer = juce::Image();
+  requestRefresh();
 }
 
-void SpectrumAnalyzerComponent::updateSpectrum(const float *spectrumData,
-                                               int numBins) {
-  // Update spectrum values
-  jassert(numBins == targetSpectrumValues.size());
+void SpectrumAnalyzerComponent::visibilityChanged() {
+  if (!isShowing())
+    setAnalysisActive(false);
+}
 
-  for (int i = 0; i < numBins; ++i) {
-    targetSpectrumValues[i] = spectrumData[i];
+void SpectrumAnalyzerComponent::parentHierarchyChanged() {
+  // Off the desktop there are no VBlank callbacks to notice it
+  if (getPeer() == nullptr || !isShowing())
+    setAnalysisActive(false);
+}
+
+void SpectrumAnalyzerComponent::setAnalysisActive(bool shouldBeActive) {
+  if (analysisActive == shouldBeActive)
+    return;
+
+  analysisActive = shouldBeActive;
+  processorRef.setSpectrumAnalyzerActive(shouldBeActive);
+
+  // The worker outlives editors and may still run at the idle rate of the
+  // last one; start again at full rate, as a fresh display
+  if (shouldBeActive) {
+    framesSinceChange = 0;
+    processorRef.getSpectrumAnalyzerWorker().setTargetFrameRate(
+        activeFrameRate);
   }
 }
 
-void SpectrumAnalyzerComponent::timerCallback() {
-  // Smooth spectrum values for display
+void SpectrumAnalyzerComponent::requestRefresh() {
+  // Settings changed: redraw on the next VBlank and animate any transition
+  // at full rate
+  needsRedraw = true;
+  framesSinceChange = 0;
+}
+
+void SpectrumAnalyzerComponent::onVBlank(double timestampSec) {
+  // Minimised or hidden windows may keep sending VBlanks: do nothing, and
+  // stop the analysis until we are visible again
+  const bool showing = isShowing();
+  setAnalysisActive(showing);
+  if (!showing)
+    return;
+
+  // A frame is still being drawn in the background: leave its state alone
+  // and look again on the next VBlank
+  if (renderInFlight.load(std::memory_order_acquire))
+    return;
+  if (frameReady.exchange(false))
+    repaint();
+
+  // Once the display has settled, only look for new audio at the idle rate
+  const bool idle = framesSinceChange >= framesUntilIdle;
+  if (idle && timestampSec - lastRefreshTime < 1.0 / idleFrameRate)
+    return;
+  // Wall-clock time drives the animation, so it moves at the same speed at
+  // any refresh rate; after a long gap (first frame, hidden window) it
+  // simply resumes
+  const double elapsed = timestampSec - lastRefreshTime;
+  lastRefreshTime = timestampSec;
+
+  if (advanceFrame(elapsed < maxElapsedSeconds ? elapsed
+                                               : WavePhysics::stepSeconds)) {
+    framesSinceChange = 0;
+    presentFrame();
+  } else if (framesSinceChange < framesUntilIdle) {
+    ++framesSinceChange;
+  }
+
+  // The worker does not need to analyse faster than we display
+  const bool nowIdle = framesSinceChange >= framesUntilIdle;
+  if (nowIdle != idle)
+    processorRef.getSpectrumAnalyzerWorker().setTargetFrameRate(
+        nowIdle ? idleFrameRate : activeFrameRate);
+}
+
+bool SpectrumAnalyzerComponent::advanceFrame(double elapsedSeconds) {
+  bool changed = std::exchange(needsRedraw, false);
+
+  // Pull the newest complete frame from the analyzer thread (lock-free; keeps
+  // the previous target if nothing new has been analysed yet)
+  if (processorRef.pullSpectrumFrame(
+          latestFrame.data(), (int)latestFrame.size(), view,
+          showInput ? latestInputFrame.data() : nullptr)) {
+    const float newCorrelation = processorRef.getSpectrumCorrelation();
+    changed |= std::abs(newCorrelation - correlation) > settleThreshold;
+    correlation = newCorrelation;
+
+    // Snapshots identical to the current one (e.g. silence) change nothing
+    if (latestFrame != targetSpectrumValues) {
+      std::swap(latestFrame, targetSpectrumValues);
+      changed = true;
+    }
+
+    if (showInput && latestInputFrame != inputTargetValues) {
+      std::swap(latestInputFrame, inputTargetValues);
+      changed = true;
+    }
+
+    // One spectrogram column per analysis frame, unsmoothed - time keeps
+    // scrolling as long as frames arrive
+    if (animationMode == 3) {
+      writeSpectrogramColumn(targetSpectrumValues);
+      changed = true;
+    }
+  }
+
+  // Nothing new and the physics has come to rest: skip this frame
+  if (!changed && isAnimationSettled())
+    return false;
+
+  // Smooth spectrum values for display. The coefficient is per 60 Hz frame;
+  // compounding it over the elapsed time keeps the response rate independent
+  const float smoothing =
+      1.0f - std::pow(1.0f - smoothingCoefficient,
+                      (float)(elapsedSeconds / WavePhysics::stepSeconds));
   for (int i = 0; i < spectrumValues.size(); ++i) {
     previousSpectrumValues[i] = spectrumValues[i];
-    spectrumValues[i] = previousSpectrumValues[i] +
-                        smoothingCoefficient * (targetSpectrumValues[i] -
-                                                previousSpectrumValues[i]);
+    spectrumValues[i] =
+        previousSpectrumValues[i] +
+        smoothing * (targetSpectrumValues[i] - previousSpectrumValues[i]);
+  }
+
+  if (showInput) {
+    for (size_t i = 0; i < inputSpectrumValues.size(); ++i)
+      inputSpectrumValues[i] +=
+          smoothing * (inputTargetValues[i] - inputSpectrumValues[i]);
   }
 
-  // Update wave animation
-  updateAnimation();
+  // Step the wave in fixed increments towards the smoothed spectrum
+  wavePhysics.advance(spectrumValues.data(), elapsedSeconds);
 
-  // Request a repaint
-  repaint();
+  if (animationMode == 2)
+    updateParticles((float)elapsedSeconds);
+
+  return true;
 }
 
-void SpectrumAnalyzerComponent::updateAnimation() {
-  // Update wave targets based on spectrum values
-  for (int i = 0; i < waveTargets.size(); ++i) {
-    waveTargets[i] = spectrumValues[i];
+void SpectrumAnalyzerComponent::presentFrame() {
+  if (renderThread == nullptr) {
+    repaint();
+    return;
   }
 
-  // Physics-based animation for wave points
-  for (int i = 0; i < wavePoints.size(); ++i) {
-    // Apply spring force towards target
-    float force = tension * (waveTargets[i] - wavePoints[i]);
-    waveVelocities[i] += force;
+  // Hand the frame over; the state stays untouched until renderInFlight
+  // clears
+  frameBounds = getLocalBounds();
+  frameScale = lastPaintScale;
+  renderInFlight.store(true, std::memory_order_release);
+  renderThread->notify();
+}
 
-    // Apply velocity to position
-    wavePoints[i] += waveVelocities[i] * animationSpeed;
+void SpectrumAnalyzerComponent::renderNextFrame() {
+  // paint() may be drawing the front image; the other one is ours
+  const int back = frontFrame.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+  const int width = juce::jmax(
+      1, juce::roundToInt((float)frameBounds.getWidth() * frameScale));
+  const int height = juce::jmax(
+      1, juce::roundToInt((float)frameBounds.getHeight() * frameScale));
+
+  // Only reallocates when the size changes. Software images, because native
+  // ones (e.g. Direct2D) may only be drawn on the message thread.
+  auto &image = renderedFrames[back];
+  if (image.getWidth() != width || image.getHeight() != height)
+    image = juce::Image(juce::Image::ARGB, width, height, false,
+                        juce::SoftwareImageType());
 
-    // Apply damping
-    waveVelocities[i] *= damping;
+  {
+    juce::Graphics g(image);
+    g.addTransform(juce::AffineTransform::scale(frameScale));
+    renderFrame(g, frameScale);
   }
 
-  // Apply spreading/smoothing between adjacent points (fluid-like behavior)
-  std::vector<float> spreadForces(wavePoints.size(), 0.0f);
+  renderedFrameScales[back] = frameScale;
+  frontFrame.store(back, std::memory_order_release);
+  frameReady.store(true);
+  renderInFlight.store(false, std::memory_order_release);
+  frameFinished.signal();
+}
 
-  for (int i = 1; i < wavePoints.size() - 1; ++i) {
-    float leftDiff = wavePoints[i - 1] - wavePoints[i];
-    float rightDiff = wavePoints[i + 1] - wavePoints[i];
-    spreadForces[i] = spreadFactor * (leftDiff + rightDiff);
+void SpectrumAnalyzerComponent::RenderThread::run() {
+  while (!threadShouldExit()) {
+    wait(-1);
+
+    if (!threadShouldExit() &&
+        owner.renderInFlight.load(std::memory_order_acquire))
+      owner.renderNextFrame();
+  }
+}
+
+void SpectrumAnalyzerComponent::finishPendingFrame() {
+  while (renderInFlight.load(std::memory_order_acquire))
+    frameFinished.wait(5);
+}
+
+const juce::ImageType &SpectrumAnalyzerComponent::getLayerImageType() const {
+  static const juce::SoftwareImageType software;
+  static const juce::NativeImageType native;
+
+  if (renderThread != nullptr)
+    return software;
+  return native;
+}
+
+void SpectrumAnalyzerComponent::setBackgroundRendering(
+    bool shouldRenderOnThread) {
+  if (shouldRenderOnThread == (renderThread != nullptr))
+    return;
+
+  if (shouldRenderOnThread) {
+    renderThread = std::make_unique<RenderThread>(*this);
+  } else {
+    finishPendingFrame();
+    renderThread->signalThreadShouldExit();
+    renderThread->notify();
+    renderThread->stopThread(1000);
+    renderThread.reset();
+
+    frontFrame.store(-1);
+    frameReady.store(false);
+    renderedFrames[0] = juce::Image();
+    renderedFrames[1] = juce::Image();
+  }
+
+  // Layers drawn while rendering follow the image type of the new mode
+  const auto &type = getLayerImageType();
+  spectrogramImage = type.convert(spectrogramImage);
+  particleSprites = type.convert(particleSprites);
+  staticLayer = juce::Image();
+  barsImage = juce::Image();
+
+  if (renderThread != nullptr)
+    renderThread->startThread(juce::Thread::Priority::low);
+
+  requestRefresh();
+}
+
+bool SpectrumAnalyzerComponent::isAnimationSettled() const {
+  if (animationMode == 2 && particles.size() > 0)
+    return false;
+
+  for (size_t i = 0; i < spectrumValues.size(); ++i) {
+    if (std::abs(targetSpectrumValues[i] - spectrumValues[i]) >
+        settleThreshold)
+      return false;
   }
 
-  // Apply spread forces
-  for (int i = 1; i < wavePoints.size() - 1; ++i) {
-    waveVelocities[i] += spreadForces[i];
+  if (!wavePhysics.isSettled(spectrumValues.data(), settleThreshold))
+    return false;
+
+  if (showInput) {
+    for (size_t i = 0; i < inputSpectrumValues.size(); ++i)
+      if (std::abs(inputTargetValues[i] - inputSpectrumValues[i]) >
+          settleThreshold)
+        return false;
   }
+
+  return true;
 }
 
 void SpectrumAnalyzerComponent::setAnimationMode(int mode) {
-  animationMode = mode % 3; // Ensure it's 0, 1, or 2
+  finishPendingFrame();
+  animationMode = mode % 4; // Ensure it's 0, 1, 2 or 3
+
+  particles.clear();
+
+  // Start the spectrogram from an empty history
+  if (animationMode == 3) {
+    spectrogramImage.clear(spectrogramImage.getBounds(), juce::Colours::black);
+    spectrogramWriteColumn = 0;
+  }
+
+  requestRefresh();
+}
+
+void SpectrumAnalyzerComponent::setView(SpectrumAnalyzerWorker::View newView) {
+  finishPendingFrame();
+  view = newView;
+  requestRefresh();
+}
+
+void SpectrumAnalyzerComponent::setShowInput(bool shouldShowInput) {
+  finishPendingFrame();
+  showInput = shouldShowInput;
+
+  // The worker skips the input transform while nothing displays it
+  processorRef.getSpectrumAnalyzerWorker().setInputTapEnabled(shouldShowInput);
+
+  if (!showInput) {
+    std::fill(inputSpectrumValues.begin(), inputSpectrumValues.end(), 0.0f);
+    std::fill(inputTargetValues.begin(), inputTargetValues.end(), 0.0f);
+  }
+
+  requestRefresh();
 }
 
 void SpectrumAnalyzerComponent::setColorScheme(int scheme) {
+  finishPendingFrame();
   colorScheme = scheme % 3; // Ensure it's 0, 1, or 2
 
   // Update colors based on scheme
@@ -320,6 +865,114 @@ void SpectrumAnalyzerComponent::setColorScheme(int scheme) {
     baseColour2 = juce::Colours::yellow;
     break;
   }
+
+  rebuildSpectrogramPalette();
+  rebuildBarPalette();
+  rebuildParticleSprites();
+  staticLayer = juce::Image();
+  requestRefresh();
+}
+
+//==============================================================================
+// MorphPadComponent Implementation
+//==============================================================================
+
+MorphPadComponent::MorphPadComponent(CustomReverbAudioProcessor &processor)
+    : audioProcessor(processor) {}
+
+juce::Rectangle<float> MorphPadComponent::getPadArea() const {
+  return getLocalBounds().toFloat().reduced(1.0f);
+}
+
+void MorphPadComponent::paint(juce::Graphics &g) {
+  const auto area = getPadArea();
+  const bool enabled = audioProcessor.isMorphPadEnabled();
+
+  g.setColour(juce::Colours::black.withAlpha(0.4f));
+  g.fillRoundedRectangle(area, 6.0f);
+  g.setColour(juce::Colours::white.withAlpha(enabled ? 0.6f : 0.25f));
+  g.drawRoundedRectangle(area, 6.0f, 1.0f);
+
+  // Corner presets: bottom left, bottom right, top left, top right
+  g.setFont(11.0f);
+  const auto inner = area.reduced(4.0f);
+  const float labelHeight = 14.0f;
+  for (int corner = 0; corner < CustomReverbAudioProcessor::numMorphCorners;
+       ++corner) {
+    const bool right = (corner & 1) != 0;
+    const bool top = corner >= 2;
+    const juce::Rectangle<float> labelArea(
+        right ? inner.getCentreX() : inner.getX(),
+        top ? inner.getY() : inner.getBottom() - labelHeight,
+        inner.getWidth() / 2.0f, labelHeight);
+    g.drawText(
+        audioProcessor.getProgramName(audioProcessor.getMorphPreset(corner)),
+        labelArea,
+        right ? juce::Justification::centredRight
+              : juce::Justification::centredLeft,
+        true);
+  }
+
+  // Morph position, y pointing up
+  const auto position = audioProcessor.getMorphPosition();
+  const float x = area.getX() + position.getX() * area.getWidth();
+  const float y = area.getBottom() - position.getY() * area.getHeight();
+  g.setColour(juce::Colours::cyan.withAlpha(enabled ? 1.0f : 0.4f));
+  g.fillEllipse(x - 6.0f, y - 6.0f, 12.0f, 12.0f);
+}
+
+void MorphPadComponent::mouseDown(const juce::MouseEvent &e) {
+  if (e.mods.isPopupMenu())
+    showCornerMenu(e.position);
+  else
+    setPositionFromMouse(e.position);
+}
+
+void MorphPadComponent::mouseDrag(const juce::MouseEvent &e) {
+  if (!e.mods.isPopupMenu())
+    setPositionFromMouse(e.position);
+}
+
+void MorphPadComponent::setPositionFromMouse(
+    juce::Point<float> mousePosition) {
+  // Only two atomics change; the audio thread does the rest
+  const auto area = getPadArea();
+  audioProcessor.setMorphPosition(
+      (mousePosition.getX() - area.getX()) / area.getWidth(),
+      (area.getBottom() - mousePosition.getY()) / area.getHeight());
+  repaint();
+}
+
+void MorphPadComponent::showCornerMenu(juce::Point<float> mousePosition) {
+  const auto area = getPadArea();
+  const bool right = mousePosition.getX() > area.getCentreX();
+  const bool top = mousePosition.getY() < area.getCentreY();
+  const int corner = (top ? 2 : 0) + (right ? 1 : 0);
+
+  juce::PopupMenu menu;
+  menu.addSectionHeader("Corner Preset");
+  for (int i = 0; i < audioProcessor.getNumPrograms(); ++i)
+    menu.addItem(i + 1, audioProcessor.getProgramName(i), true,
+                 i == audioProcessor.getMorphPreset(corner));
+
+  menu.showMenuAsync(
+      juce::PopupMenu::Options().withTargetComponent(this),
+      [safeThis = juce::Component::SafePointer<MorphPadComponent>(this),
+       corner](int result) {
+        if (safeThis != nullptr && result > 0)
+          safeThis->assignCornerPreset(corner, result - 1);
+      });
+}
+
+void MorphPadComponent::assignCornerPreset(int corner, int presetIndex) {
+  int presets[CustomReverbAudioProcessor::numMorphCorners];
+  for (int i = 0; i < CustomReverbAudioProcessor::numMorphCorners; ++i)
+    presets[i] = audioProcessor.getMorphPreset(i);
+  presets[corner] = presetIndex;
+
+  audioProcessor.setMorphPresets(presets,
+                                 CustomReverbAudioProcessor::numMorphCorners);
+  repaint();
 }
 
 //==============================================================================
@@ -328,7 +981,8 @@ void SpectrumAnalyzerComponent::setColorScheme(int scheme) {
 
 CustomReverbAudioProcessorEditor::CustomReverbAudioProcessorEditor(
     CustomReverbAudioProcessor &p)
-    : AudioProcessorEditor(&p), audioProcessor(p), spectrumAnalyzer(p) {
+    : AudioProcessorEditor(&p), audioProcessor(p), spectrumAnalyzer(p),
+      morphPad(p) {
   // Set up custom look and feel
   customLookAndFeel.setColour(juce::Slider::thumbColourId,
                               juce::Colour(100, 180, 240));
@@ -466,7 +1120,7 @@ CustomReverbAudioProcessorEditor::CustomReverbAudioProcessorEditor(
 
   harmDetuneAmountAttachment.reset(
       new juce::AudioProcessorValueTreeState::SliderAttachment(
-          apvts, "harmonicDetune", harmDetuneAmountSlider));
+          apvts, "harmDetuneAmount", harmDetuneAmountSlider));
   // Freeze Mode Button
   freezeModeButton.setButtonText("Freeze");
   addAndMakeVisible(freezeModeButton);
@@ -483,8 +1137,10 @@ CustomReverbAudioProcessorEditor::CustomReverbAudioProcessorEditor(
   presetLabel.setJustificationType(juce::Justification::centred);
   addAndMakeVisible(presetLabel);
 
-  // Spectrum analyzer
+  // Spectrum analyzer, drawn off the message thread so that several open
+  // instances do not stall the host's UI
   addAndMakeVisible(spectrumAnalyzer);
+  spectrumAnalyzer.setBackgroundRendering(true);
 
   spectrumLabel.setText("Spectrum Analyzer", juce::dontSendNotification);
   spectrumLabel.setJustificationType(juce::Justification::centred);
@@ -499,8 +1155,45 @@ CustomReverbAudioProcessorEditor::CustomReverbAudioProcessorEditor(
   colorSchemeButton.onClick = [this] { cycleColorScheme(); };
   addAndMakeVisible(colorSchemeButton);
 
+  // The analyzer belongs to the processor and keeps its settings while no
+  // editor is open, so the buttons start from what it still does
+  auto &analyzerWorker = audioProcessor.getSpectrumAnalyzerWorker();
+  currentOverlap = static_cast<int>(analyzerWorker.getOverlap());
+  multiResolution = analyzerWorker.getResolution() ==
+                    SpectrumAnalyzerWorker::Resolution::multi;
+  showInputSpectrum = analyzerWorker.isInputTapEnabled();
+  spectrumAnalyzer.setShowInput(showInputSpectrum);
+  updateAnalyzerButtons();
+
+  overlapButton.onClick = [this] { cycleAnalyzerOverlap(); };
+  addAndMakeVisible(overlapButton);
+
+  resolutionButton.onClick = [this] { toggleAnalyzerResolution(); };
+  addAndMakeVisible(resolutionButton);
+
+  viewButton.setButtonText("View: Mid");
+  viewButton.onClick = [this] { cycleAnalyzerView(); };
+  addAndMakeVisible(viewButton);
+
+  inputTapButton.onClick = [this] { toggleInputOverlay(); };
+  addAndMakeVisible(inputTapButton);
+
+  // Morph pad, off until switched on so the parameters stay in charge
+  addAndMakeVisible(morphPad);
+  morphPadButton.setButtonText("Morph Pad");
+  morphPadButton.setToggleState(audioProcessor.isMorphPadEnabled(),
+                                juce::dontSendNotification);
+  morphPadButton.onClick = [this] {
+    audioProcessor.setMorphPadEnabled(morphPadButton.getToggleState());
+    morphPad.repaint();
+  };
+  addAndMakeVisible(morphPadButton);
+
+  // The background cache covers every pixel
+  setOpaque(true);
+
   // Set the initial size of the editor
-  setSize(600, 500);
+  setSize(780, 500);
 }
 
 CustomReverbAudioProcessorEditor::~CustomReverbAudioProcessorEditor() {
@@ -518,6 +1211,20 @@ CustomReverbAudioProcessorEditor::~CustomReverbAudioProcessorEditor() {
 
 //==============================================================================
 void CustomReverbAudioProcessorEditor::paint(juce::Graphics &g) {
+  // The gradient and title only change with the size, so they are rendered
+  // once and blitted afterwards
+  const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+  if (!backgroundCache.isValid() || backgroundCacheScale != scale) {
+    backgroundCache = renderCachedLayer(
+        getWidth(), getHeight(), scale, juce::NativeImageType(),
+        [this](juce::Graphics &layer) { paintBackground(layer); });
+    backgroundCacheScale = scale;
+  }
+
+  drawCachedLayer(g, backgroundCache, backgroundCacheScale);
+}
+
+void CustomReverbAudioProcessorEditor::paintBackground(juce::Graphics &g) {
   // Fill the background
   g.fillAll(juce::Colour(30, 40, 50));
 
@@ -537,6 +1244,8 @@ void CustomReverbAudioProcessorEditor::paint(juce::Graphics &g) {
 }
 
 void CustomReverbAudioProcessorEditor::resized() {
+  backgroundCache = juce::Image(); // Re-rendered at the new size
+
   auto area = getLocalBounds().reduced(20);
   auto topArea = area.removeFromTop(40); // Title area
 
@@ -544,15 +1253,26 @@ void CustomReverbAudioProcessorEditor::resized() {
   auto spectrumArea = area.removeFromTop(200);
   spectrumLabel.setBounds(spectrumArea.removeFromTop(20));
 
-  // Animation control buttons
-  auto buttonArea = spectrumArea.removeFromBottom(30);
-  animationStyleButton.setBounds(buttonArea.removeFromLeft(150));
-  colorSchemeButton.setBounds(buttonArea.removeFromLeft(150));
+  // Animation control buttons, two rows of three
+  auto buttonArea = spectrumArea.removeFromBottom(48);
+  auto styleRow = buttonArea.removeFromTop(24);
+  const int buttonWidth = buttonArea.getWidth() / 3;
+  animationStyleButton.setBounds(styleRow.removeFromLeft(buttonWidth));
+  colorSchemeButton.setBounds(styleRow.removeFromLeft(buttonWidth));
+  viewButton.setBounds(styleRow);
+  overlapButton.setBounds(buttonArea.removeFromLeft(buttonWidth));
+  resolutionButton.setBounds(buttonArea.removeFromLeft(buttonWidth));
+  inputTapButton.setBounds(buttonArea);
 
   spectrumAnalyzer.setBounds(spectrumArea);
 
-  // Parameter controls in the bottom section
+  // Parameter controls in the bottom section, the morph pad beside them
   auto controlsArea = area.reduced(0, 10);
+  auto morphArea = controlsArea.removeFromRight(180).reduced(10, 0);
+  morphPadButton.setBounds(morphArea.removeFromBottom(30).reduced(0, 3));
+  morphPad.setBounds(morphArea.withSizeKeepingCentre(
+      morphArea.getWidth(),
+      juce::jmin(morphArea.getWidth(), morphArea.getHeight())));
 
   // First row of controls
   auto row1 = controlsArea.removeFromTop(120);
@@ -612,125 +1332,22 @@ void CustomReverbAudioProcessorEditor::resized() {
 }
 
 void CustomReverbAudioProcessorEditor::setupPresetMenu() {
-  presetSelector.addItem("Small Room", 1);
-  presetSelector.addItem("Medium Room", 2);
-  presetSelector.addItem("Large Hall", 3);
-  presetSelector.addItem("Cathedral", 4);
-  presetSelector.addItem("Special FX", 5);
-  presetSelector.addItem("Bright Chamber", 6);
-  presetSelector.addItem("Dark Space", 7);
-  presetSelector.addItem("Harmonic Detuner", 8);
+  // The presets live in the processor's bank, so the host's program list
+  // and this menu are the same thing
+  for (int i = 0; i < audioProcessor.getNumPrograms(); ++i)
+    presetSelector.addItem(audioProcessor.getProgramName(i), i + 1);
 
   presetSelector.onChange = [this] {
-    loadPreset(presetSelector.getSelectedItemIndex());
+    audioProcessor.setCurrentProgram(presetSelector.getSelectedItemIndex());
   };
-  presetSelector.setSelectedItemIndex(0);
-}
-
-void CustomReverbAudioProcessorEditor::loadPreset(int presetIndex) {
-  auto &apvts = audioProcessor.getAPVTS();
 
-  switch (presetIndex) {
-  case 0: // Small Room
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.6f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.25f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.8f);
-    apvts.getParameter("width")->setValueNotifyingHost(0.5f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(0.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.2f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.4f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.0f);
-    break;
-
-  case 1: // Medium Room
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.5f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.5f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.33f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.7f);
-    apvts.getParameter("width")->setValueNotifyingHost(0.7f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(0.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.5f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.0f);
-    break;
-
-  case 2: // Large Hall
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.85f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.4f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.6f);
-    apvts.getParameter("width")->setValueNotifyingHost(1.0f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(0.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.4f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.0f);
-    break;
-
-  case 3: // Cathedral
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.95f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.2f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.5f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.5f);
-    apvts.getParameter("width")->setValueNotifyingHost(1.0f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(0.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.7f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.2f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.0f);
-    break;
-
-  case 4: // Special FX
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.9f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.1f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.9f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.2f);
-    apvts.getParameter("width")->setValueNotifyingHost(1.0f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(1.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.8f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.7f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.0f);
-    break;
-
-  case 5: // Bright Chamber
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.4f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.7f);
-    apvts.getParameter("width")->setValueNotifyingHost(0.8f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(0.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.1f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.8f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.0f);
-    break;
-
-  case 6: // Dark Space
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.8f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.8f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.4f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.6f);
-    apvts.getParameter("width")->setValueNotifyingHost(0.9f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(0.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.5f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.0f);
-    break;
-
-  case 7: // Harmonic Detuner
-    apvts.getParameter("roomSize")->setValueNotifyingHost(0.4f);
-    apvts.getParameter("damping")->setValueNotifyingHost(0.4f);
-    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.7f);
-    apvts.getParameter("width")->setValueNotifyingHost(0.7f);
-    apvts.getParameter("freezeMode")->setValueNotifyingHost(0.0f);
-    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.3f);
-    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.6f);
-    apvts.getParameter("harmonicDetune")->setValueNotifyingHost(0.7f);
-    break;
-  }
+  // Show the current program without reloading it over the session's values
+  presetSelector.setSelectedItemIndex(audioProcessor.getCurrentProgram(),
+                                      juce::dontSendNotification);
 }
 
 void CustomReverbAudioProcessorEditor::cycleAnimationStyle() {
-  currentAnimationStyle = (currentAnimationStyle + 1) % 3;
+  currentAnimationStyle = (currentAnimationStyle + 1) % 4;
   spectrumAnalyzer.setAnimationMode(currentAnimationStyle);
 
   // Update button text
@@ -745,6 +1362,9 @@ void CustomReverbAudioProcessorEditor::cycleAnimationStyle() {
   case 2:
     styleName = "Particles";
     break;
+  case 3:
+    styleName = "Spectrogram";
+    break;
   }
   animationStyleButton.setButtonText("Animation: " + styleName);
 }
@@ -768,3 +1388,54 @@ void CustomReverbAudioProcessorEditor::cycleColorScheme() {
   }
   colorSchemeButton.setButtonText("Color: " + schemeName);
 }
+
+void CustomReverbAudioProcessorEditor::cycleAnalyzerOverlap() {
+  currentOverlap = (currentOverlap + 1) % 3;
+
+  // Update the analysis hop and button text
+  using Overlap = SpectrumAnalyzerWorker::Overlap;
+  const Overlap overlaps[] = {Overlap::half, Overlap::threeQuarters,
+                              Overlap::sevenEighths};
+  audioProcessor.getSpectrumAnalyzerWorker().setOverlap(
+      overlaps[currentOverlap]);
+  updateAnalyzerButtons();
+}
+
+void CustomReverbAudioProcessorEditor::toggleAnalyzerResolution() {
+  multiResolution = !multiResolution;
+
+  // Multi-resolution trades low-frequency time resolution for frequency
+  // resolution, so it is off by default
+  using Resolution = SpectrumAnalyzerWorker::Resolution;
+  audioProcessor.getSpectrumAnalyzerWorker().setResolution(
+      multiResolution ? Resolution::multi : Resolution::single);
+  updateAnalyzerButtons();
+}
+
+void CustomReverbAudioProcessorEditor::cycleAnalyzerView() {
+  currentView = (currentView + 1) % SpectrumAnalyzerWorker::numViews;
+
+  // Update the displayed spectrum and button text
+  using View = SpectrumAnalyzerWorker::View;
+  const View views[] = {View::mid, View::side, View::left, View::right};
+  const char *viewNames[] = {"Mid", "Side", "Left", "Right"};
+
+  spectrumAnalyzer.setView(views[currentView]);
+  viewButton.setButtonText(juce::String("View: ") + viewNames[currentView]);
+}
+
+void CustomReverbAudioProcessorEditor::toggleInputOverlay() {
+  showInputSpectrum = !showInputSpectrum;
+
+  spectrumAnalyzer.setShowInput(showInputSpectrum);
+  updateAnalyzerButtons();
+}
+
+void CustomReverbAudioProcessorEditor::updateAnalyzerButtons() {
+  const char *overlapNames[] = {"50%", "75%", "87.5%"};
+  overlapButton.setButtonText(juce::String("Overlap: ") +
+                              overlapNames[currentOverlap]);
+  resolutionButton.setButtonText(multiResolution ? "Resolution: Multi"
+                                                 : "Resolution: Single");
+  inputTapButton.setButtonText(showInputSpectrum ? "Input: On" : "Input: Off");
+}
@@ -31,6 +31,8 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "ParticlePool.h"
+#include "WavePhysics.h"
 
 //==============================================================================
 /**
@@ -43,8 +45,7 @@
  *
  * Displays a real-time FFT of the audio output with an animated fluid wave visualization
  */
-class SpectrumAnalyzerComponent : public juce::Component,
-                                 private juce::Timer
+class SpectrumAnalyzerComponent : public juce::Component
 {
 public:
     SpectrumAnalyzerComponent(CustomReverbAudioProcessor& processor);
@@ -53,18 +54,92 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
     
-    // Called from the processor to update the spectrum data
-    void updateSpectrum(const float* spectrumData, int numBins);
-    
     // Control the animation style
     void setAnimationMode(int mode);
     void setColorScheme(int scheme);
     
+    // Choose which stereo spectrum (mid/side/left/right) is displayed
+    void setView(SpectrumAnalyzerWorker::View newView);
+    
+    // Overlay the spectrum of the dry input for before/after comparison
+    void setShowInput(bool shouldShowInput);
+    
+    // Draw frames on a background thread into off-screen images, so paint()
+    // only blits the newest one. Off by default.
+    void setBackgroundRendering(bool shouldRenderOnThread);
+    
 private:
-    void timerCallback() override;
+    // Draws frames handed over by presentFrame() (see setBackgroundRendering)
+    class RenderThread : public juce::Thread
+    {
+    public:
+        explicit RenderThread(SpectrumAnalyzerComponent& ownerToUse)
+            : juce::Thread("Spectrum Renderer"), owner(ownerToUse) {}
+        
+        void run() override;
+        
+    private:
+        SpectrumAnalyzerComponent& owner;
+    };
+    
+
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+    
+    // Refresh scheduling: every VBlank while something moves, the idle rate
+    // once the display has settled, nothing while hidden
+    void onVBlank(double timestampSec);
+    void requestRefresh();
+    void setAnalysisActive(bool shouldBeActive);
+    
+    // Pulls a frame and steps the animation by the time since the last
+    // refresh; false if nothing would change
+    bool advanceFrame(double elapsedSeconds);
+    bool isAnimationSettled() const;
+    
+    // Frame rendering: everything paint() used to draw, at a given physical
+    // pixel scale and within frameBounds. Runs on the message thread or, with
+    // background rendering, on renderThread.
+    void renderFrame(juce::Graphics& g, float scale);
+    
+    // Shows the state advanceFrame() produced: a repaint, or a frame handed
+    // to the renderer
+    void presentFrame();
+    
+    // Renderer side of the hand-over; draws into the back image and swaps
+    void renderNextFrame();
     
-    // Animation parameters
-    void updateAnimation();
+    // Blocks until the renderer is done with the frame in flight, so the
+    // state it reads can change (message thread)
+    void finishPendingFrame();
+    
+    // Image type for layers the renderer may draw from another thread
+    const juce::ImageType& getLayerImageType() const;
+    
+    // Draws the background grid and the frequency axis
+    void drawGridAndLabels(juce::Graphics& g, float width, float height);
+    
+    // Draws the L/R phase correlation meter in the top right corner
+    void drawCorrelationMeter(juce::Graphics& g);
+    
+    // Draws the dry input spectrum as an outline over the output
+    void drawInputOverlay(juce::Graphics& g, float scale);
+    
+    // Spectrogram mode: appends one analysis frame to the history image and
+    // blits the history
+    void writeSpectrogramColumn(const std::vector<float>& levels);
+    void drawSpectrogram(juce::Graphics& g);
+    void rebuildSpectrogramPalette();
+    
+    // Bars mode: bands max-pooled to one column per device pixel and written
+    // straight into an image
+    void renderBars(float scale);
+    void rebuildBarPalette();
+    
+    // Particles mode: a fixed-size pool drawn with pre-rendered sprites
+    void updateParticles(float deltaTime);
+    void drawParticles(juce::Graphics& g);
+    void rebuildParticleSprites();
     
     CustomReverbAudioProcessor& processorRef;
     
@@ -77,29 +152,127 @@ private:
     std::vector<float> spectrumValues;
     std::vector<float> previousSpectrumValues;
     std::vector<float> targetSpectrumValues;
+    std::vector<float> inputSpectrumValues;
+    std::vector<float> inputTargetValues;
+    std::vector<float> latestFrame;      // Newest pulled snapshot (output)
+    std::vector<float> latestInputFrame; // Newest pulled snapshot (input)
     
-    // Wave animation data
-    std::vector<float> wavePoints;
-    std::vector<float> waveVelocities;
-    std::vector<float> waveTargets;
+    // Wave animation (fixed-timestep spring solver, chasing spectrumValues)
+    WavePhysics wavePhysics;
     
     // Animation properties
-    float smoothingCoefficient = 0.2f;
-    float animationSpeed = 0.05f;
-    int animationMode = 0; // 0=Wave, 1=Bars, 2=Particles
+    float smoothingCoefficient = 0.2f; // Per 60 Hz frame
+    int animationMode = 0; // 0=Wave, 1=Bars, 2=Particles, 3=Spectrogram
     int colorScheme = 0;   // 0=Blue/Cyan, 1=Purple/Pink, 2=Green/Yellow
     bool useGradient = true;
     
-    // Fluid dynamics parameters
-    float damping = 0.97f;
-    float tension = 0.025f;
-    float spreadFactor = 0.2f;
+    // Stereo analysis
+    SpectrumAnalyzerWorker::View view = SpectrumAnalyzerWorker::View::mid;
+    float correlation = 0.0f; // -1 (out of phase) to +1 (mono)
+    bool showInput = false;
+    
+    // Spectrogram history: a circular buffer of columns (one per analysis
+    // frame, low frequencies at the bottom) and a level -> colour table
+    static constexpr int spectrogramHistory = 512;
+    juce::Image spectrogramImage;
+    int spectrogramWriteColumn = 0; // Next column to write (= oldest)
+    juce::PixelARGB spectrogramPalette[256];
+    
+    // Bars image, per-column scratch and level -> colour tables (native
+    // ARGB pixels)
+    juce::Image barsImage;
+    std::vector<std::int32_t> barTops;
+    std::vector<std::uint32_t> barBody;
+    std::vector<std::uint32_t> barHighlight;
+    std::uint32_t barBodyPalette[256];
+    std::uint32_t barHighlightPalette[256];
+    const DspKernels::KernelTable* kernels = &DspKernels::getBestKernels();
+    
+    // Particle pool (normalised coordinates) and its sprite sheet
+    static constexpr int maxParticles = 1024;
+    static constexpr int maxSpawnsPerFrame = 48;
+    static constexpr int particleHues = 8;     // Sprite sheet columns
+    static constexpr int particleSizes = 4;    // Sprite sheet rows
+    static constexpr int particleCellSize = 8; // Pixels per sprite
+    static constexpr float particleGravity = 0.6f; // Component heights/s^2
+    static constexpr float particleDrag = 0.98f;   // Velocity kept per step
+    ParticlePool particles{maxParticles};
+    XorShiftRandom particleRandom;
+    juce::Image particleSprites;
+    
+    // Wave and input overlay outlines, cleared and refilled every frame so
+    // their storage is only allocated once
+    juce::Path wavePath;
+    juce::Path inputPath;
+    
+    // Background, grid and labels rendered once; cleared on resize and
+    // colour scheme changes
+    juce::Image staticLayer;
+    float staticLayerScale = 1.0f;
+    bool staticLayerHasLabels = false;
+    
+    // Refresh state
+    static constexpr double activeFrameRate = 60.0; // Analysis rate (Hz)
+    static constexpr double idleFrameRate = 10.0;   // Hz once settled
+    static constexpr int framesUntilIdle = 30; // Unchanged frames before idling
+    static constexpr float settleThreshold = 1.0e-3f; // In display units (0-1)
+    static constexpr double maxElapsedSeconds = 0.25; // Longer gaps restart
+    std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
+    double lastRefreshTime = 0.0;
+    int framesSinceChange = 0;
+    bool needsRedraw = true;
+    bool analysisActive = false;
+    
+    // Background rendering. The message thread only touches render state
+    // while no frame is in flight; the renderer draws into the image that is
+    // not at frontFrame and publishes it by storing its index.
+    std::unique_ptr<RenderThread> renderThread;
+    juce::Rectangle<int> frameBounds; // Bounds of the frame being rendered
+    float frameScale = 1.0f;          // Its physical pixel scale
+    float lastPaintScale = 1.0f;      // Scale of the last paint (message thread)
+    juce::Image renderedFrames[2];
+    float renderedFrameScales[2] = {1.0f, 1.0f};
+    std::atomic<int> frontFrame{-1};  // Newest finished frame, -1 if none
+    std::atomic<bool> renderInFlight{false};
+    std::atomic<bool> frameReady{false}; // Finished but not yet repainted
+    juce::WaitableEvent frameFinished;
     
     juce::Random random;
     juce::Colour baseColour1 = juce::Colours::blue;
     juce::Colour baseColour2 = juce::Colours::cyan;
 };
 
+//==============================================================================
+/**
+ * MorphPadComponent
+ *
+ * XY pad over the processor's morph pad. Dragging moves the morph position,
+ * which the audio thread picks up at its next block without touching any
+ * parameter. A right click on a quarter of the pad assigns a preset to that
+ * corner.
+ */
+class MorphPadComponent : public juce::Component
+{
+public:
+    explicit MorphPadComponent(CustomReverbAudioProcessor& processor);
+
+    void paint(juce::Graphics& g) override;
+    void mouseDown(const juce::MouseEvent& e) override;
+    void mouseDrag(const juce::MouseEvent& e) override;
+
+private:
+    CustomReverbAudioProcessor& audioProcessor;
+
+    // Area the position maps to (inside the border)
+    juce::Rectangle<float> getPadArea() const;
+
+    void setPositionFromMouse(juce::Point<float> mousePosition);
+    void showCornerMenu(juce::Point<float> mousePosition);
+    void assignCornerPreset(int corner, int presetIndex);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MorphPadComponent)
+};
+
 //==============================================================================
 /**
  * CustomReverbAudioProcessorEditor
@@ -112,6 +285,7 @@ private:
  * - Harmonic detuning for enhanced stereo imaging
  * - High-frequency delay for more natural decay
  * - Preset management system
+ * - XY pad for morphing between presets
  */
 class CustomReverbAudioProcessorEditor  : public juce::AudioProcessorEditor
 {
@@ -145,6 +319,14 @@ private:
     SpectrumAnalyzerComponent spectrumAnalyzer;
     juce::TextButton animationStyleButton;
     juce::TextButton colorSchemeButton;
+    juce::TextButton overlapButton;
+    juce::TextButton resolutionButton;
+    juce::TextButton viewButton;
+    juce::TextButton inputTapButton;
+
+    // Preset morph pad
+    MorphPadComponent morphPad;
+    juce::ToggleButton morphPadButton;
     
     // Labels for sliders
     juce::Label roomSizeLabel;
@@ -171,18 +353,31 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> harmDetuneAmountAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> freezeModeAttachment;
     
+    // Gradient and title rendered once per size
+    void paintBackground(juce::Graphics& g);
+    juce::Image backgroundCache;
+    float backgroundCacheScale = 1.0f;
+    
     // Custom LookAndFeel for the sliders
     juce::LookAndFeel_V4 customLookAndFeel;
     
-    // Preset handling methods
+    // Fills the preset menu from the processor's preset bank
     void setupPresetMenu();
-    void loadPreset(int presetIndex);
     
     // Animation/visualization style methods
     void cycleAnimationStyle();
     void cycleColorScheme();
+    void cycleAnalyzerOverlap();
+    void toggleAnalyzerResolution();
+    void cycleAnalyzerView();
+    void toggleInputOverlay();
+    void updateAnalyzerButtons();
     int currentAnimationStyle = 0;
     int currentColorScheme = 0;
+    int currentOverlap = 1; // 0=50%, 1=75%, 2=87.5%
+    bool multiResolution = false;
+    int currentView = 0; // 0=Mid, 1=Side, 2=Left, 3=Right
+    bool showInputSpectrum = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CustomReverbAudioProcessorEditor)
 };
@@ -30,11 +30,32 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+#include <cstring>
+
 // Define M_PI for Windows if it's not already defined
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+/** One-pole low-pass coefficient for a crossover frequency */
+float crossoverCoefficient(float frequency, float sampleRate) {
+  return 1.0f - (float)std::exp(-2.0f * M_PI * frequency / sampleRate);
+}
+
+/** Changes a smoothed value's ramp time; reset() alone would also jump it
+ * to its target */
+template <typename Smoother>
+void setSmootherRampLength(Smoother &smoother, double sampleRate,
+                           double seconds) {
+  const auto current = smoother.getCurrentValue();
+  const auto target = smoother.getTargetValue();
+  smoother.reset(sampleRate, seconds);
+  smoother.setCurrentAndTargetValue(current);
+  smoother.setTargetValue(target);
+}
+} // namespace
+
 //==============================================================================
 // Parameter IDs constant for automated listener management
 const std::vector<std::string> CustomReverbAudioProcessor::parameterIDs = {
@@ -48,18 +69,21 @@ CustomReverbAudioProcessor::CustomReverbAudioProcessor()
           BusesProperties()
               .withInput("Input", juce::AudioChannelSet::stereo(), true)
               .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      forwardFFT(fftOrder),
-      window(fftSize, juce::dsp::WindowingFunction<float>::hann),
       apvts(*this, nullptr, "Parameters", createParameters()) {
   // Initialize memory for high frequency delay
-  highFreqBufferSize =
+  dsp.highFreqBufferSize =
       static_cast<int>(defaultSampleRate); // 1 second at default sample rate
-  highFreqDelayBufferL.resize(highFreqBufferSize, 0.0f);
-  highFreqDelayBufferR.resize(highFreqBufferSize, 0.0f);
+  dsp.highFreqDelayBufferL.resize(dsp.highFreqBufferSize, 0.0f);
+  dsp.highFreqDelayBufferR.resize(dsp.highFreqBufferSize, 0.0f);
 
   // Initialize harmonic detuning buffers
-  oddHarmonicBufferL.resize(maxHarmonicFilterSize, 0.0f);
-  evenHarmonicBufferR.resize(maxHarmonicFilterSize, 0.0f);
+  dsp.oddHarmonicBufferL.resize(maxHarmonicFilterSize, 0.0f);
+  dsp.evenHarmonicBufferR.resize(maxHarmonicFilterSize, 0.0f);
+
+  // Band buffers for a typical block size until prepareToPlay knows better
+  lowFreqBuffer.setSize(2, 512);
+  delayedHighFreqBuffer.setSize(4, 512);
+  analyzerInputBuffer.setSize(2, 512);
 
   // Set up default reverb parameters
   reverbParams.roomSize = 0.5f;
@@ -70,22 +94,12 @@ CustomReverbAudioProcessor::CustomReverbAudioProcessor()
   reverbParams.freezeMode = 0.0f;
 
   // Initialize crossover frequency
-  customParams.crossover = defaultCrossoverFreq;
-  customParams.highFreqDelay = 0.1f; // 100ms default
-  customParams.highFreqDelayMix = 0.3f;
+  dsp.customParams.crossover = defaultCrossoverFreq;
+  dsp.customParams.highFreqDelay = 0.1f; // 100ms default
+  dsp.customParams.highFreqDelayMix = 0.3f;
 
   // Initialize harmonic detuning
-  customParams.harmDetuneAmount = 0.5f;
-
-  // Setup spectrum analyzer using helper methods
-  // fftSize = 1 << fftOrder;
-  // fifo.resize(fftSize, 0.0f);
-  // fftData = new float[2 * fftSize];
-  // scopeData = new float[scopeSize];
-  clearFixedArray(fftData, 2 * fftSize);
-  clearFixedArray(scopeData, scopeSize);
-  fifoIndex = 0;
-  nextFFTBlockReady = false;
+  dsp.customParams.harmDetuneAmount = 0.5f;
 
   // Initialize the reverb processors
   leftReverb.reset();
@@ -93,81 +107,398 @@ CustomReverbAudioProcessor::CustomReverbAudioProcessor()
   leftReverb.setParameters(reverbParams);
   rightReverb.setParameters(reverbParams);
 
-  // Initialize parameter listeners using helper method
+  // Cache the raw parameter values, parameters and ID hashes, build a first
+  // snapshot and forward every later change by index
+  for (int i = 0; i < numParameters; ++i) {
+    rawParameters[i] = apvts.getRawParameterValue(parameterIDs[i]);
+    parameters[i] = apvts.getParameter(parameterIDs[i]);
+    parameterIDHashes[i] =
+        ParameterState::hashParameterID(parameterIDs[i].c_str());
+    parameterListeners[i].owner = this;
+    parameterListeners[i].index = static_cast<ParameterIndex>(i);
+  }
+  rebuildParameterSnapshots(defaultSampleRate);
+  resetParameterSmoothing(defaultSampleRate);
   setupParameterListeners();
+
+  // Morph pad: rooms on the bottom edge, the coloured spaces on the top
+  const int defaultMorphPresets[] = {0, 2, 5, 6};
+  setMorphPresets(defaultMorphPresets, numMorphCorners);
 }
 
 CustomReverbAudioProcessor::~CustomReverbAudioProcessor() {
-  // Clean up memory
-  // delete[] fftData;
-  // delete[] scopeData;
+  // Make sure the analysis thread is gone before our members are destroyed
+  if (analyzerWorker != nullptr)
+    analyzerWorker->stop();
 
   // Remove parameter listeners using helper method
   removeParameterListeners();
 }
 
 //==============================================================================
-void CustomReverbAudioProcessor::parameterChanged(
-    const juce::String &parameterID, float newValue) {
-  // Update parameters based on changes in the GUI or automation
-  if (parameterID == roomSizeParamID)
-    reverbParams.roomSize = newValue;
-  else if (parameterID == dampingParamID)
-    reverbParams.damping = newValue;
-  else if (parameterID == wetLevelParamID)
-    reverbParams.wetLevel = newValue;
-  else if (parameterID == dryLevelParamID)
-    reverbParams.dryLevel = newValue;
-  else if (parameterID == widthParamID)
-    reverbParams.width = newValue;
-  else if (parameterID == freezeModeParamID)
-    reverbParams.freezeMode = newValue;
-  else if (parameterID == crossoverFreqParamID)
-    customParams.crossover = 20.0f * std::pow(1000.0f, newValue);
-  else if (parameterID == highFreqDelayParamID)
-    customParams.highFreqDelay = juce::jmap(newValue, 0.001f, 0.5f);
-  else if (parameterID == highFreqMixParamID)
-    customParams.highFreqDelayMix = newValue;
-  else if (parameterID == harmDetuneAmountParamID)
-    customParams.harmDetuneAmount = newValue;
-
-  // Update the reverb processors with new parameters
-  if (parameterID == roomSizeParamID || parameterID == dampingParamID ||
-      parameterID == wetLevelParamID || parameterID == dryLevelParamID ||
-      parameterID == widthParamID || parameterID == freezeModeParamID) {
+// Factory presets: plain values in ParameterIndex order (room size, damping,
+// wet, dry, width, freeze, crossover, HF delay, HF mix, harmonic detune)
+const CustomReverbAudioProcessor::PresetDefinition
+    CustomReverbAudioProcessor::presetDefinitions[numPresets] = {
+        {"Small Room",
+         {0.3f, 0.6f, 0.25f, 0.8f, 0.5f, 0.0f, 0.4f, 0.2f, 0.3f, 0.0f}},
+        {"Medium Room",
+         {0.5f, 0.5f, 0.33f, 0.7f, 0.7f, 0.0f, 0.5f, 0.3f, 0.3f, 0.0f}},
+        {"Large Hall",
+         {0.85f, 0.3f, 0.4f, 0.6f, 1.0f, 0.0f, 0.3f, 0.4f, 0.3f, 0.0f}},
+        {"Cathedral",
+         {0.95f, 0.2f, 0.5f, 0.5f, 1.0f, 0.0f, 0.2f, 0.7f, 0.3f, 0.0f}},
+        {"Special FX",
+         {0.9f, 0.1f, 0.9f, 0.2f, 1.0f, 1.0f, 0.7f, 0.8f, 0.3f, 0.0f}},
+        {"Bright Chamber",
+         {0.4f, 0.3f, 0.3f, 0.7f, 0.8f, 0.0f, 0.8f, 0.1f, 0.3f, 0.0f}},
+        {"Dark Space",
+         {0.8f, 0.8f, 0.4f, 0.6f, 0.9f, 0.0f, 0.3f, 0.5f, 0.3f, 0.0f}},
+        {"Harmonic Detuner",
+         {0.4f, 0.4f, 0.3f, 0.7f, 0.7f, 0.0f, 0.6f, 0.3f, 0.3f, 0.7f}}};
+
+//==============================================================================
+void CustomReverbAudioProcessor::publishParameterChange(ParameterIndex index) {
+  // The value is already in the raw atomic; release makes it visible to the
+  // audio thread together with the bit
+  changedParameters.fetch_or(1u << index, std::memory_order_release);
+}
+
+void CustomReverbAudioProcessor::rebuildParameterSnapshots(float sampleRate) {
+  // Every value is read again below, so the pending change flags are spent
+  changedParameters.exchange(0, std::memory_order_acquire);
+
+  activeParameters.custom.sampleRate = sampleRate;
+  for (int i = 0; i < numParameters; ++i) {
+    activeParameters.values[i] = rawParameters[i]->load();
+    deriveSnapshotParameter(activeParameters, static_cast<ParameterIndex>(i));
+  }
+  ++activeParameters.reverbVersion;
+
+  // Preset values go through the parameters' ranges once, so loading one
+  // later leaves exactly these values in the parameters
+  for (int preset = 0; preset < numPresets; ++preset) {
+    auto &snapshot = presetSnapshots[preset];
+    snapshot.custom.sampleRate = sampleRate;
+    for (int i = 0; i < numParameters; ++i) {
+      snapshot.values[i] = parameters[i]->convertFrom0to1(
+          parameters[i]->convertTo0to1(presetDefinitions[preset].values[i]));
+      deriveSnapshotParameter(snapshot, static_cast<ParameterIndex>(i));
+    }
+  }
+}
+
+bool CustomReverbAudioProcessor::setSnapshotParameter(
+    ParameterSnapshot &snapshot, ParameterIndex index, float value) {
+  if (snapshot.values[index] == value)
+    return false;
+
+  snapshot.values[index] = value;
+  deriveSnapshotParameter(snapshot, index);
+
+  // Reverb parameters come first in ParameterIndex
+  if (index <= freezeModeIndex)
+    ++snapshot.reverbVersion;
+  return true;
+}
+
+void CustomReverbAudioProcessor::deriveSnapshotParameter(
+    ParameterSnapshot &snapshot, ParameterIndex index) {
+  auto &custom = snapshot.custom;
+  auto &reverb = snapshot.reverb;
+  const float value = snapshot.values[index];
+
+  switch (index) {
+  case roomSizeIndex:
+    reverb.roomSize = value;
+    break;
+  case dampingIndex:
+    reverb.damping = value;
+    break;
+  case wetLevelIndex:
+    reverb.wetLevel = value;
+    break;
+  case dryLevelIndex:
+    reverb.dryLevel = value;
+    break;
+  case widthIndex:
+    reverb.width = value;
+    break;
+  case freezeModeIndex:
+    reverb.freezeMode = value;
+    break;
+
+  // Crossover: 20Hz - 20kHz (the audio thread derives the coefficient as
+  // it ramps)
+  case crossoverFreqIndex:
+    custom.crossover = 20.0f * std::pow(1000.0f, value);
+    break;
+
+  // High frequency delay: 1ms - 500ms, then the delay in samples
+  case highFreqDelayIndex:
+    custom.highFreqDelay = juce::jmap(value, 0.001f, 0.5f);
+    snapshot.highFreqDelaySamples =
+        static_cast<int>(custom.highFreqDelay * custom.sampleRate);
+    break;
+
+  case highFreqMixIndex:
+    custom.highFreqDelayMix = value;
+    break;
+  case harmDetuneAmountIndex:
+    custom.harmDetuneAmount = value;
+    break;
+  case numParameters:
+    break;
+  }
+}
+
+void CustomReverbAudioProcessor::loadPreset(int index, float morphSeconds) {
+  if (!juce::isPositiveAndBelow(index, numPresets))
+    return;
+
+  // The audio thread swaps in the whole precomputed preset at its next
+  // block; index and morph time travel in one word
+  const float morph = juce::jmax(0.0f, morphSeconds);
+  std::uint32_t morphBits;
+  std::memcpy(&morphBits, &morph, sizeof(morphBits));
+  presetRequest.store((static_cast<std::uint64_t>(morphBits) << 32) |
+                          static_cast<std::uint32_t>(index + 1),
+                      std::memory_order_release);
+  currentPreset.store(index);
+
+  // Then the parameters follow for the host and the editor. The preset
+  // snapshot already holds these values, so the audio thread finds nothing
+  // to change when it folds them in.
+  for (int i = 0; i < numParameters; ++i)
+    parameters[i]->setValueNotifyingHost(
+        parameters[i]->convertTo0to1(presetDefinitions[index].values[i]));
+  updateHostDisplay(ChangeDetails().withProgramChanged(true));
+}
+
+void CustomReverbAudioProcessor::adoptParameterSnapshot() {
+  // After the morph pad, the current snapshot is applied again even if
+  // nothing changed. Flags are taken before the preset request: a flag set
+  // by a preset load then guarantees its request is seen too.
+  const bool reapply = std::exchange(parameterSnapshotOverridden, false);
+  const std::uint32_t changed =
+      changedParameters.exchange(0, std::memory_order_acquire);
+  const std::uint64_t request =
+      presetRequest.exchange(0, std::memory_order_acquire);
+  if (changed == 0 && request == 0 && !reapply)
+    return;
+
+  // A preset replaces the whole snapshot in one copy
+  float morphSeconds = 0.0f;
+  if (request != 0) {
+    const auto reverbVersion = activeParameters.reverbVersion;
+    const int preset = static_cast<int>(request & 0xffffffffu) - 1;
+    activeParameters = presetSnapshots[preset];
+    activeParameters.reverbVersion = reverbVersion + 1;
+
+    const auto morphBits = static_cast<std::uint32_t>(request >> 32);
+    std::memcpy(&morphSeconds, &morphBits, sizeof(morphSeconds));
+  }
+
+  // Changed parameters are derived from their current values; the ones a
+  // preset load set already hold them, so they stop here
+  bool parametersChanged = false;
+  for (int i = 0; i < numParameters; ++i)
+    if ((changed & (1u << i)) != 0)
+      parametersChanged |= setSnapshotParameter(
+          activeParameters, static_cast<ParameterIndex>(i),
+          rawParameters[i]->load(std::memory_order_relaxed));
+  if (request == 0 && !parametersChanged && !reapply)
+    return;
+
+  const auto &snapshot = activeParameters;
+  dsp.customParams = snapshot.custom;
+  dsp.highFreqDelayTarget = juce::jlimit(1, dsp.highFreqBufferSize - 1,
+                                         snapshot.highFreqDelaySamples);
+
+  // A newly loaded preset may take longer than the usual ramps; any other
+  // change ends a morph and ramps at the usual speed again
+  const bool startMorph = request != 0 && morphSeconds > 0.0f;
+  setRampLength(startMorph ? morphSeconds : smoothingTimeSec);
+
+  // Values that would click if they jumped ramp from where they are
+  dsp.highFreqMixSmoother.setTargetValue(dsp.customParams.highFreqDelayMix);
+  dsp.harmDetuneSmoother.setTargetValue(dsp.customParams.harmDetuneAmount);
+  dsp.crossoverSmoother.setTargetValue(dsp.customParams.crossover);
+
+  // Reverb updates recompute its filters, so only when a reverb parameter
+  // changed or a morph ends early
+  if (startMorph) {
+    morphStartReverb = reverbParams;
+    morphTargetReverb = snapshot.reverb;
+    morphLengthSamples = juce::jmax(
+        1, static_cast<int>(morphSeconds * dsp.customParams.sampleRate));
+    morphSamplesRemaining = morphLengthSamples;
+  } else if (snapshot.reverbVersion != appliedReverbVersion || reapply ||
+             morphSamplesRemaining > 0) {
+    morphSamplesRemaining = 0;
+    reverbParams = snapshot.reverb;
+    updateReverbParameters();
+  }
+  appliedReverbVersion = snapshot.reverbVersion;
+}
+
+void CustomReverbAudioProcessor::setMorphPresets(const int *presetIndices,
+                                                 int numPresetsToMorph) {
+  if (numPresetsToMorph < 2 || numPresetsToMorph > numMorphCorners)
+    return;
+
+  // Fewer presets share corners: A B A B, or A B C C
+  static constexpr int cornerSources[numMorphCorners - 1][numMorphCorners] = {
+      {0, 1, 0, 1}, {0, 1, 2, 2}, {0, 1, 2, 3}};
+  for (int corner = 0; corner < numMorphCorners; ++corner) {
+    const int preset =
+        presetIndices[cornerSources[numPresetsToMorph - 2][corner]];
+    morphCornerPresets[corner].store(juce::jlimit(0, numPresets - 1, preset));
+  }
+}
+
+void CustomReverbAudioProcessor::applyMorphPad() {
+  const float x = morphX.load(std::memory_order_relaxed);
+  const float y = morphY.load(std::memory_order_relaxed);
+  int corners[numMorphCorners];
+  for (int corner = 0; corner < numMorphCorners; ++corner)
+    corners[corner] =
+        morphCornerPresets[corner].load(std::memory_order_relaxed);
+
+  // Nothing to derive while the pad stands still
+  const bool firstBlock = !morphPadApplied;
+  if (!firstBlock && x == appliedMorphX && y == appliedMorphY &&
+      std::equal(corners, corners + numMorphCorners, appliedMorphCorners))
+    return;
+
+  morphPadApplied = true;
+  parameterSnapshotOverridden = true;
+  appliedMorphX = x;
+  appliedMorphY = y;
+  std::copy_n(corners, numMorphCorners, appliedMorphCorners);
+
+  // Bilinear weights of the corners. The snapshots hold plain parameter
+  // values, so the crossover moves evenly in octaves.
+  const float weights[numMorphCorners] = {(1.0f - x) * (1.0f - y),
+                                          x * (1.0f - y), (1.0f - x) * y,
+                                          x * y};
+  morphSnapshot.custom.sampleRate = dsp.customParams.sampleRate;
+  for (int i = 0; i < numParameters; ++i) {
+    const auto index = static_cast<ParameterIndex>(i);
+    float value = 0.0f;
+    for (int corner = 0; corner < numMorphCorners; ++corner)
+      value += weights[corner] * presetSnapshots[corners[corner]].values[i];
+
+    // After enabling everything is derived once; later blocks only derive
+    // what moved
+    if (firstBlock) {
+      morphSnapshot.values[i] = value;
+      deriveSnapshotParameter(morphSnapshot, index);
+    } else {
+      setSnapshotParameter(morphSnapshot, index, value);
+    }
+  }
+  if (firstBlock)
+    ++morphSnapshot.reverbVersion;
+
+  // Apply like a parameter snapshot, at the usual ramp speed; the delay
+  // crossfades to its new time instead of jumping every block
+  dsp.customParams = morphSnapshot.custom;
+  dsp.highFreqDelayTarget = juce::jlimit(1, dsp.highFreqBufferSize - 1,
+                                         morphSnapshot.highFreqDelaySamples);
+  morphSamplesRemaining = 0;
+  setRampLength(smoothingTimeSec);
+  dsp.highFreqMixSmoother.setTargetValue(dsp.customParams.highFreqDelayMix);
+  dsp.harmDetuneSmoother.setTargetValue(dsp.customParams.harmDetuneAmount);
+  dsp.crossoverSmoother.setTargetValue(dsp.customParams.crossover);
+
+  if (morphSnapshot.reverbVersion != appliedMorphReverbVersion) {
+    appliedMorphReverbVersion = morphSnapshot.reverbVersion;
+    reverbParams = morphSnapshot.reverb;
     updateReverbParameters();
   }
 }
 
+void CustomReverbAudioProcessor::advancePresetMorph(int numSamples) {
+  if (morphSamplesRemaining <= 0)
+    return;
+
+  morphSamplesRemaining = juce::jmax(0, morphSamplesRemaining - numSamples);
+  const float position =
+      1.0f - (float)morphSamplesRemaining / (float)morphLengthSamples;
+  auto interpolate = [position](float start, float target) {
+    return start + (target - start) * position;
+  };
+
+  reverbParams.roomSize =
+      interpolate(morphStartReverb.roomSize, morphTargetReverb.roomSize);
+  reverbParams.damping =
+      interpolate(morphStartReverb.damping, morphTargetReverb.damping);
+  reverbParams.wetLevel =
+      interpolate(morphStartReverb.wetLevel, morphTargetReverb.wetLevel);
+  reverbParams.dryLevel =
+      interpolate(morphStartReverb.dryLevel, morphTargetReverb.dryLevel);
+  reverbParams.width =
+      interpolate(morphStartReverb.width, morphTargetReverb.width);
+  reverbParams.freezeMode =
+      interpolate(morphStartReverb.freezeMode, morphTargetReverb.freezeMode);
+  updateReverbParameters();
+}
+
 void CustomReverbAudioProcessor::updateReverbParameters() {
   leftReverb.setParameters(reverbParams);
   rightReverb.setParameters(reverbParams);
 }
 
-void CustomReverbAudioProcessor::updateHighFreqParameters() {
-  // Calculate delay time in samples based on the sample rate
-  int highFreqDelaySamples =
-      static_cast<int>(customParams.highFreqDelay * getSampleRate());
+void CustomReverbAudioProcessor::resetParameterSmoothing(double sampleRate) {
+  // Take over anything pending, then apply the whole snapshot
+  adoptParameterSnapshot();
+  dsp.customParams = activeParameters.custom;
+  dsp.highFreqDelaySamples = dsp.highFreqDelayTarget = juce::jlimit(
+      1, dsp.highFreqBufferSize - 1, activeParameters.highFreqDelaySamples);
+
+  // No morph or delay fade survives a reset either
+  dsp.highFreqFadeRemaining = 0;
+  morphSamplesRemaining = 0;
+  morphPadApplied = false;
+  appliedReverbVersion = activeParameters.reverbVersion;
+  reverbParams = activeParameters.reverb;
+  updateReverbParameters();
+
+  rampLengthSec = smoothingTimeSec;
+  dsp.highFreqMixSmoother.reset(sampleRate, smoothingTimeSec);
+  dsp.harmDetuneSmoother.reset(sampleRate, smoothingTimeSec);
+  dsp.crossoverSmoother.reset(sampleRate, smoothingTimeSec);
+  const CustomReverbParameters &params = dsp.customParams;
+  dsp.highFreqMixSmoother.setCurrentAndTargetValue(params.highFreqDelayMix);
+  dsp.harmDetuneSmoother.setCurrentAndTargetValue(params.harmDetuneAmount);
+  dsp.crossoverSmoother.setCurrentAndTargetValue(params.crossover);
+  dsp.lowpassCoeff = crossoverCoefficient(params.crossover, params.sampleRate);
+}
 
-  // Ensure delay buffer is large enough - use helper method
-  resizeDelayBuffers(highFreqDelaySamples);
+void CustomReverbAudioProcessor::setRampLength(double seconds) {
+  if (seconds == rampLengthSec)
+    return;
 
-  // Reset delay buffer write position when parameters change significantly
-  highFreqDelayWritePos = 0;
+  rampLengthSec = seconds;
+  const double sampleRate = dsp.customParams.sampleRate;
+  setSmootherRampLength(dsp.highFreqMixSmoother, sampleRate, seconds);
+  setSmootherRampLength(dsp.harmDetuneSmoother, sampleRate, seconds);
+  setSmootherRampLength(dsp.crossoverSmoother, sampleRate, seconds);
 }
 
 //==============================================================================
 // Helper Methods Implementation
 
 void CustomReverbAudioProcessor::setupParameterListeners() {
-  for (const auto &paramID : parameterIDs) {
-    apvts.addParameterListener(paramID, this);
+  for (int i = 0; i < numParameters; ++i) {
+    apvts.addParameterListener(parameterIDs[i], &parameterListeners[i]);
   }
 }
 
 void CustomReverbAudioProcessor::removeParameterListeners() {
-  for (const auto &paramID : parameterIDs) {
-    apvts.removeParameterListener(paramID, this);
+  for (int i = 0; i < numParameters; ++i) {
+    apvts.removeParameterListener(parameterIDs[i], &parameterListeners[i]);
   }
 }
 
@@ -181,10 +512,10 @@ void CustomReverbAudioProcessor::clearFixedArray(float *array, size_t size) {
 }
 
 void CustomReverbAudioProcessor::resizeDelayBuffers(int newSize) {
-  if (newSize > highFreqBufferSize) {
-    highFreqBufferSize = newSize;
-    highFreqDelayBufferL.resize(highFreqBufferSize, 0.0f);
-    highFreqDelayBufferR.resize(highFreqBufferSize, 0.0f);
+  if (newSize > dsp.highFreqBufferSize) {
+    dsp.highFreqBufferSize = newSize;
+    dsp.highFreqDelayBufferL.resize(dsp.highFreqBufferSize, 0.0f);
+    dsp.highFreqDelayBufferR.resize(dsp.highFreqBufferSize, 0.0f);
   }
 }
 
@@ -232,20 +563,22 @@ double CustomReverbAudioProcessor::getTailLengthSeconds() const {
 }
 
 int CustomReverbAudioProcessor::getNumPrograms() {
-  return 1; // NB: some hosts don't cope very well if you tell them there are 0
-            // programs, so this should be at least 1, even if you're not really
-            // implementing programs.
+  return numPresets; // NB: some hosts don't cope very well if you tell them
+                     // there are 0 programs, so this should be at least 1
 }
 
-int CustomReverbAudioProcessor::getCurrentProgram() { return 0; }
+int CustomReverbAudioProcessor::getCurrentProgram() {
+  return currentPreset.load();
+}
 
 void CustomReverbAudioProcessor::setCurrentProgram(int index) {
-  (void)index; // Suppress unused parameter warning
+  loadPreset(index, presetMorphSeconds.load());
 }
 
 const juce::String CustomReverbAudioProcessor::getProgramName(int index) {
-  (void)index; // Suppress unused parameter warning
-  return {};
+  if (!juce::isPositiveAndBelow(index, numPresets))
+    return {};
+  return presetDefinitions[index].name;
 }
 
 void CustomReverbAudioProcessor::changeProgramName(
@@ -257,9 +590,7 @@ void CustomReverbAudioProcessor::changeProgramName(
 //==============================================================================
 void CustomReverbAudioProcessor::prepareToPlay(double sampleRate,
                                                int samplesPerBlock) {
-  (void)samplesPerBlock; // Suppress unused parameter warning
-
-  customParams.sampleRate = static_cast<float>(sampleRate);
+  dsp.customParams.sampleRate = static_cast<float>(sampleRate);
 
   // Resize delay buffer for new sample rate (max delay time) using helper
   int requiredSize = static_cast<int>(maxDelayTimeSec * sampleRate) + 1;
@@ -268,23 +599,34 @@ void CustomReverbAudioProcessor::prepareToPlay(double sampleRate,
   // Reset all DSP state
   leftReverb.reset();
   rightReverb.reset();
-  lowpassStateL = 0.0f;
-  lowpassStateR = 0.0f;
-  highFreqDelayWritePos = 0;
-  highFreqDelayReadPos = 0;
-  oddHarmonicPos = 0;
-  evenHarmonicPos = 0;
+  dsp.lowpassStateL = 0.0f;
+  dsp.lowpassStateR = 0.0f;
+  dsp.highFreqDelayWritePos = 0;
+  dsp.highFreqDelayReadPos = 0;
+  dsp.oddHarmonicPos = 0;
+  dsp.evenHarmonicPos = 0;
   // Clear all buffers using helper methods
-  clearBuffer(highFreqDelayBufferL);
-  clearBuffer(highFreqDelayBufferR);
-  clearBuffer(oddHarmonicBufferL);
-  clearBuffer(evenHarmonicBufferR);
-
-  // Clear FFT and spectrum data
-  clearFixedArray(fftData, 2 * fftSize);
-  clearFixedArray(scopeData, scopeSize);
-  fifoIndex = 0;
-  nextFFTBlockReady = false;
+  clearBuffer(dsp.highFreqDelayBufferL);
+  clearBuffer(dsp.highFreqDelayBufferR);
+  clearBuffer(dsp.oddHarmonicBufferL);
+  clearBuffer(dsp.evenHarmonicBufferR);
+
+  // Band buffers for one block, and the fastest kernels this CPU supports
+  lowFreqBuffer.setSize(2, juce::jmax(1, samplesPerBlock));
+  delayedHighFreqBuffer.setSize(4, juce::jmax(1, samplesPerBlock));
+  analyzerInputBuffer.setSize(2, juce::jmax(1, samplesPerBlock));
+  dsp.kernels = &DspKernels::getBestKernels();
+
+  // Everything derived from the parameters depends on the sample rate; the
+  // first block starts at the current values instead of ramping to them
+  rebuildParameterSnapshots(static_cast<float>(sampleRate));
+  resetParameterSmoothing(sampleRate);
+
+  // Prepare the spectrum analyzer, or remember the rate for when it exists
+  const juce::CriticalSection::ScopedLockType lock(analyzerLock);
+  analyzerSampleRate = sampleRate;
+  if (analyzerWorker != nullptr)
+    analyzerWorker->prepare(sampleRate);
 }
 
 void CustomReverbAudioProcessor::releaseResources() {
@@ -304,39 +646,40 @@ bool CustomReverbAudioProcessor::isBusesLayoutSupported(
 }
 // Process harmonic detuning on stereo channels
 void CustomReverbAudioProcessor::processHarmonicDetuning(float &leftSample,
-                                                         float &rightSample) {
-  if (customParams.harmDetuneAmount <= 0.001f) {
+                                                         float &rightSample,
+                                                         float amount) {
+  if (amount <= 0.001f) {
     return; // Skip processing if detuning is disabled
   }
 
   // Get the detune amount (0-1 maps to 0-10 Hz shift)
-  float detuneAmount = customParams.harmDetuneAmount * 10.0f;
+  float detuneAmount = amount * 10.0f;
 
   // Store samples in odd/even harmonic buffers
-  oddHarmonicBufferL[oddHarmonicPos] = leftSample;
-  evenHarmonicBufferR[evenHarmonicPos] = rightSample;
+  dsp.oddHarmonicBufferL[dsp.oddHarmonicPos] = leftSample;
+  dsp.evenHarmonicBufferR[dsp.evenHarmonicPos] = rightSample;
 
   // Calculate the phase shift amount for the sample rate
   float phaseShiftSamples =
-      detuneAmount / customParams.sampleRate * maxHarmonicFilterSize;
+      detuneAmount / dsp.customParams.sampleRate * maxHarmonicFilterSize;
 
   // Detune odd harmonics in left channel
-  int readPos = oddHarmonicPos -
+  int readPos = dsp.oddHarmonicPos -
                 static_cast<int>(phaseShiftSamples) % maxHarmonicFilterSize;
   if (readPos < 0)
     readPos += maxHarmonicFilterSize;
-  leftSample = oddHarmonicBufferL[readPos];
+  leftSample = dsp.oddHarmonicBufferL[readPos];
 
   // Detune even harmonics in right channel (opposite direction)
-  readPos = evenHarmonicPos +
+  readPos = dsp.evenHarmonicPos +
             static_cast<int>(phaseShiftSamples) % maxHarmonicFilterSize;
   if (readPos >= maxHarmonicFilterSize)
     readPos -= maxHarmonicFilterSize;
-  rightSample = evenHarmonicBufferR[readPos];
+  rightSample = dsp.evenHarmonicBufferR[readPos];
 
   // Update buffer positions
-  oddHarmonicPos = (oddHarmonicPos + 1) % maxHarmonicFilterSize;
-  evenHarmonicPos = (evenHarmonicPos + 1) % maxHarmonicFilterSize;
+  dsp.oddHarmonicPos = (dsp.oddHarmonicPos + 1) % maxHarmonicFilterSize;
+  dsp.evenHarmonicPos = (dsp.evenHarmonicPos + 1) % maxHarmonicFilterSize;
 }
 
 void CustomReverbAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
@@ -350,128 +693,188 @@ void CustomReverbAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
   for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
     buffer.clear(i, 0, buffer.getNumSamples());
 
+  // New parameter values (or morph pad positions) arrive only here, between
+  // blocks; the smoothed ones then ramp towards them sample by sample, and a
+  // preset morph moves the reverb on once per block
+  if (morphPadEnabled.load(std::memory_order_relaxed)) {
+    applyMorphPad();
+  } else {
+    morphPadApplied = false;
+    adoptParameterSnapshot();
+    advancePresetMorph(buffer.getNumSamples());
+  }
+
   const int numSamples = buffer.getNumSamples();
   float *leftChannel = buffer.getWritePointer(0);
   float *rightChannel = buffer.getWritePointer(1);
 
-  // --- Step 1: Push input into FFT fifo for spectrum analyzer ---
-  for (int i = 0; i < numSamples; ++i) {
-    float monoSample = (leftChannel[i] + rightChannel[i]) * 0.5f;
-    pushNextSampleIntoFifo(monoSample);
-  }
-
-  // --- Step 2: Split into low/high bands, process high-freq delay
-  // sample-by-sample --- We need temporary buffers for the low-frequency
-  // content to feed into the block reverb
-  juce::AudioBuffer<float> lowFreqBuffer(2, numSamples);
-  lowFreqBuffer.clear();
-
-  for (int sample = 0; sample < numSamples; ++sample) {
-    float leftSample = leftChannel[sample];
-    float rightSample = rightChannel[sample];
+  // The band buffers are sized in prepareToPlay; hosts may still send larger
+  // blocks, so process in buffer-sized sections
+  const int sectionSize = lowFreqBuffer.getNumSamples();
+  for (int offset = 0; offset < numSamples; offset += sectionSize)
+    processSection(leftChannel + offset, rightChannel + offset,
+                   juce::jmin(sectionSize, numSamples - offset));
+}
 
-    // Split into low and high frequency bands
-    float leftLow, leftHigh, rightLow, rightHigh;
-    processCrossover(leftSample, rightSample, leftLow, leftHigh, rightLow,
-                     rightHigh);
+void CustomReverbAudioProcessor::processSection(float *left, float *right,
+                                                int numSamples) {
+  float *lowLeft = lowFreqBuffer.getWritePointer(0);
+  float *lowRight = lowFreqBuffer.getWritePointer(1);
 
-    // Store low-frequency content for block-based reverb processing
-    lowFreqBuffer.setSample(0, sample, leftLow);
-    lowFreqBuffer.setSample(1, sample, rightLow);
+  // --- Step 1: Keep the dry input for the spectrum analyzer's input tap
+  // (only while an editor is open) ---
+  SpectrumAnalyzerWorker *analyzer =
+      dsp.analyzer.load(std::memory_order_acquire);
+  const bool analyzerActive = analyzer != nullptr && analyzer->isActive();
+  float *dryLeft = analyzerInputBuffer.getWritePointer(0);
+  float *dryRight = analyzerInputBuffer.getWritePointer(1);
+  if (analyzerActive) {
+    juce::FloatVectorOperations::copy(dryLeft, left, numSamples);
+    juce::FloatVectorOperations::copy(dryRight, right, numSamples);
+  }
 
-    // Process high frequencies through the delay and write back
-    float leftHighDelay, rightHighDelay;
-    processHighFreqDelay(leftHigh, rightHigh, leftHighDelay, rightHighDelay);
+  // --- Step 2: Split into low/high bands; the high band stays in the main
+  // buffer and the low band feeds the block reverb ---
+  processCrossover(left, right, lowLeft, lowRight, numSamples);
 
-    // Store high-freq delay output back into the main buffer temporarily
-    leftChannel[sample] = leftHighDelay;
-    rightChannel[sample] = rightHighDelay;
-  }
+  // --- Step 3: Process high frequencies through the delay ---
+  processHighFreqDelay(left, right, numSamples);
 
-  // --- Step 3: Apply JUCE Reverb to low-frequency content (block-based, stereo
-  // for width) ---
-  float *lowLeft = lowFreqBuffer.getWritePointer(0);
-  float *lowRight = lowFreqBuffer.getWritePointer(1);
+  // --- Step 4: Apply JUCE Reverb to low-frequency content (block-based,
+  // stereo for width) ---
   leftReverb.processStereo(lowLeft, lowRight, numSamples);
 
-  // --- Step 4: Combine reverbed low-freq with delayed high-freq, apply
+  // --- Step 5: Combine reverbed low-freq with delayed high-freq, apply
   // harmonic detuning ---
-  for (int sample = 0; sample < numSamples; ++sample) {
-    float leftOut = lowFreqBuffer.getSample(0, sample) + leftChannel[sample];
-    float rightOut = lowFreqBuffer.getSample(1, sample) + rightChannel[sample];
+  dsp.kernels->add(left, lowLeft, left, numSamples);
+  dsp.kernels->add(right, lowRight, right, numSamples);
+
+  // Apply harmonic detuning if enabled (or ramping to or from enabled)
+  if (dsp.harmDetuneSmoother.isSmoothing() ||
+      dsp.harmDetuneSmoother.getTargetValue() > 0.001f) {
+    for (int sample = 0; sample < numSamples; ++sample)
+      processHarmonicDetuning(left[sample], right[sample],
+                              dsp.harmDetuneSmoother.getNextValue());
+  }
 
-    // Apply harmonic detuning if enabled
-    if (customParams.harmDetuneAmount > 0.001f) {
-      processHarmonicDetuning(leftOut, rightOut);
-    }
+  // --- Step 6: Feed the processed output and the dry input to the analyzer
+  // as one set of frames ---
+  if (analyzerActive)
+    analyzer->pushSamples(left, right, dryLeft, dryRight, numSamples);
+}
 
-    leftChannel[sample] = leftOut;
-    rightChannel[sample] = rightOut;
+void CustomReverbAudioProcessor::processCrossover(float *left, float *right,
+                                                  float *lowLeft,
+                                                  float *lowRight,
+                                                  int numSamples) {
+  // Simple one-pole low-pass/high-pass filter for crossover; the coefficient
+  // is recomputed only while the crossover frequency ramps
+  // Process crossover using member state variables (not static, so multiple
+  // instances work)
+  const DspKernels::KernelTable &kernels = *dsp.kernels;
+  if (!dsp.crossoverSmoother.isSmoothing()) {
+    kernels.splitOnePole(left, lowLeft, left, numSamples, dsp.lowpassCoeff,
+                         dsp.lowpassStateL);
+    kernels.splitOnePole(right, lowRight, right, numSamples, dsp.lowpassCoeff,
+                         dsp.lowpassStateR);
+    return;
   }
 
-  // Update FFT display if it's time
-  if (nextFFTBlockReady) {
-    drawNextFrameOfSpectrum();
-    nextFFTBlockReady = false;
+  // Ramping: the coefficient follows the frequency once per sub-block
+  for (int offset = 0; offset < numSamples;
+       offset += coefficientSubBlockSize) {
+    const int num = juce::jmin(coefficientSubBlockSize, numSamples - offset);
+    dsp.lowpassCoeff = crossoverCoefficient(dsp.crossoverSmoother.skip(num),
+                                            dsp.customParams.sampleRate);
+    kernels.splitOnePole(left + offset, lowLeft + offset, left + offset, num,
+                         dsp.lowpassCoeff, dsp.lowpassStateL);
+    kernels.splitOnePole(right + offset, lowRight + offset, right + offset,
+                         num, dsp.lowpassCoeff, dsp.lowpassStateR);
   }
 }
 
-void CustomReverbAudioProcessor::processCrossover(float leftIn, float rightIn,
-                                                  float &leftLow,
-                                                  float &leftHigh,
-                                                  float &rightLow,
-                                                  float &rightHigh) {
-  // Simple one-pole low-pass/high-pass filter for crossover
-  // Calculate filter coefficient from crossover frequency
-  float sampleRate = (float)getSampleRate();
-  float alpha = 1.0f - (float)std::exp(-2.0f * M_PI * customParams.crossover /
-                                       sampleRate);
+void CustomReverbAudioProcessor::processHighFreqDelay(float *left,
+                                                      float *right,
+                                                      int numSamples) {
+  // Read position follows the delay time (in samples, derived per change)
+  const int bufferSize = dsp.highFreqBufferSize;
+  float *delayBufferL = dsp.highFreqDelayBufferL.data();
+  float *delayBufferR = dsp.highFreqDelayBufferR.data();
+
+  float *delayedLeft = delayedHighFreqBuffer.getWritePointer(0);
+  float *delayedRight = delayedHighFreqBuffer.getWritePointer(1);
+  float *fadingLeft = delayedHighFreqBuffer.getWritePointer(2);
+  float *fadingRight = delayedHighFreqBuffer.getWritePointer(3);
+
+  auto readPosition = [&](int delaySamples) {
+    const int position = dsp.highFreqDelayWritePos - delaySamples;
+    return position < 0 ? position + bufferSize : position;
+  };
+
+  for (int offset = 0; offset < numSamples;) {
+    // A new delay time fades in over the current ramp length, so a preset
+    // morph moves the tap as slowly as everything else
+    if (dsp.highFreqFadeRemaining == 0 &&
+        dsp.highFreqDelayTarget != dsp.highFreqDelaySamples) {
+      dsp.highFreqFadeFromSamples = dsp.highFreqDelaySamples;
+      dsp.highFreqDelaySamples = dsp.highFreqDelayTarget;
+      dsp.highFreqFadeLength = juce::jmax(
+          1, static_cast<int>(rampLengthSec * dsp.customParams.sampleRate));
+      dsp.highFreqFadeRemaining = dsp.highFreqFadeLength;
+    }
 
-  // Process crossover using member state variables (not static, so multiple
-  // instances work)
-  lowpassStateL = lowpassStateL + alpha * (leftIn - lowpassStateL);
-  lowpassStateR = lowpassStateR + alpha * (rightIn - lowpassStateR);
-
-  leftLow = lowpassStateL;
-  rightLow = lowpassStateR;
-
-  leftHigh = leftIn - leftLow;
-  rightHigh = rightIn - rightLow;
-}
-
-void CustomReverbAudioProcessor::processHighFreqDelay(float leftIn,
-                                                      float rightIn,
-                                                      float &leftOut,
-                                                      float &rightOut) {
-  // Calculate read position based on actual delay time
-  int delaySamples =
-      static_cast<int>(customParams.highFreqDelay * getSampleRate());
-  if (delaySamples >= highFreqBufferSize)
-    delaySamples = highFreqBufferSize - 1;
-  if (delaySamples < 1)
-    delaySamples = 1;
-  highFreqDelayReadPos = highFreqDelayWritePos - delaySamples;
-  if (highFreqDelayReadPos < 0)
-    highFreqDelayReadPos += highFreqBufferSize;
-
-  // Get delayed samples
-  float leftDelayed = highFreqDelayBufferL[highFreqDelayReadPos];
-  float rightDelayed = highFreqDelayBufferR[highFreqDelayReadPos];
-
-  // Write new samples to buffer
-  highFreqDelayBufferL[highFreqDelayWritePos] = leftIn;
-  highFreqDelayBufferR[highFreqDelayWritePos] = rightIn;
-
-  // Update write position
-  highFreqDelayWritePos++;
-  if (highFreqDelayWritePos >= highFreqBufferSize)
-    highFreqDelayWritePos = 0;
-
-  // Mix original and delayed signals
-  leftOut = leftIn * (1.0f - customParams.highFreqDelayMix) +
-            leftDelayed * customParams.highFreqDelayMix;
-  rightOut = rightIn * (1.0f - customParams.highFreqDelayMix) +
-             rightDelayed * customParams.highFreqDelayMix;
+    const int delaySamples = dsp.highFreqDelaySamples;
+    dsp.highFreqDelayReadPos = readPosition(delaySamples);
+
+    // Longest run where no position wraps, nothing is read that this run
+    // writes (at most the delay of either tap) and a fade does not end
+    int num = juce::jmin(numSamples - offset, delaySamples,
+                         bufferSize - dsp.highFreqDelayReadPos,
+                         bufferSize - dsp.highFreqDelayWritePos);
+    const bool fading = dsp.highFreqFadeRemaining > 0;
+    const int fadeReadPos = readPosition(dsp.highFreqFadeFromSamples);
+    if (fading)
+      num = juce::jmin(num, dsp.highFreqFadeRemaining,
+                       dsp.highFreqFadeFromSamples, bufferSize - fadeReadPos);
+
+    // Get delayed samples
+    std::copy_n(delayBufferL + dsp.highFreqDelayReadPos, num, delayedLeft);
+    std::copy_n(delayBufferR + dsp.highFreqDelayReadPos, num, delayedRight);
+
+    // While fading, the new tap's gain rises linearly over the fade
+    if (fading) {
+      std::copy_n(delayBufferL + fadeReadPos, num, fadingLeft);
+      std::copy_n(delayBufferR + fadeReadPos, num, fadingRight);
+      const float fadeStep = 1.0f / (float)dsp.highFreqFadeLength;
+      const float fadeStart =
+          1.0f - (float)dsp.highFreqFadeRemaining * fadeStep;
+      dsp.kernels->crossfadeRamp(delayedLeft, fadingLeft, delayedLeft,
+                                 fadeStart + fadeStep, fadeStep, num);
+      dsp.kernels->crossfadeRamp(delayedRight, fadingRight, delayedRight,
+                                 fadeStart + fadeStep, fadeStep, num);
+      dsp.highFreqFadeRemaining -= num;
+    }
+
+    // Write new samples to buffer
+    std::copy_n(left + offset, num, delayBufferL + dsp.highFreqDelayWritePos);
+    std::copy_n(right + offset, num, delayBufferR + dsp.highFreqDelayWritePos);
+
+    // Update write position
+    dsp.highFreqDelayWritePos += num;
+    if (dsp.highFreqDelayWritePos >= bufferSize)
+      dsp.highFreqDelayWritePos = 0;
+
+    // Mix original and delayed signals, with the mix ramping linearly
+    // across the run (flat once it has settled)
+    const float mixStart = dsp.highFreqMixSmoother.getCurrentValue();
+    const float mixStep = (dsp.highFreqMixSmoother.skip(num) - mixStart) / num;
+    dsp.kernels->crossfadeRamp(left + offset, left + offset, delayedLeft,
+                               mixStart + mixStep, mixStep, num);
+    dsp.kernels->crossfadeRamp(right + offset, right + offset, delayedRight,
+                               mixStart + mixStep, mixStep, num);
+
+    offset += num;
+  }
 }
 
 //==============================================================================
@@ -508,71 +911,37 @@ CustomReverbAudioProcessor::createParameters() {
   return {parameters.begin(), parameters.end()};
 }
 
-void CustomReverbAudioProcessor::pushNextSampleIntoFifo(float sample) {
-  // If the fifo contains enough data, set a flag to say
-  // that the next frame should be rendered
-  if (fifoIndex == fftSize) {
-    if (!nextFFTBlockReady) {
-      clearFixedArray(fftData, 2 * fftSize);
-      std::copy(fifo, fifo + fftSize, fftData);
-      nextFFTBlockReady = true;
-    }
-
-    fifoIndex = 0;
+SpectrumAnalyzerWorker &
+CustomReverbAudioProcessor::getSpectrumAnalyzerWorker() {
+  const juce::CriticalSection::ScopedLockType lock(analyzerLock);
+  if (analyzerWorker == nullptr) {
+    analyzerWorker = std::make_unique<SpectrumAnalyzerWorker>();
+    analyzerWorker->prepare(analyzerSampleRate);
+    dsp.analyzer.store(analyzerWorker.get(), std::memory_order_release);
   }
-
-  // Add sample to the fifo
-  fifo[fifoIndex++] = sample;
+  return *analyzerWorker;
 }
 
-void CustomReverbAudioProcessor::drawNextFrameOfSpectrum() {
-  // Apply windowing function to the data
-  window.multiplyWithWindowingTable(fftData, fftSize);
-
-  // Perform the FFT
-  forwardFFT.performFrequencyOnlyForwardTransform(fftData);
-
-  // Calculate the spectrum data for display
-  float minDb = -100.0f;
-  float maxDb = 0.0f;
-
-  auto sr = getSampleRate();
-  if (sr <= 0.0)
-    sr = defaultSampleRate;
-
-  for (int i = 0; i < scopeSize; ++i) {
-    // Map scope position to frequency logarithmically (20Hz - 20kHz)
-    float proportion = static_cast<float>(i) / static_cast<float>(scopeSize);
-    float freq =
-        20.0f *
-        std::pow(1000.0f, proportion); // 20 * 1000^proportion => 20Hz to 20kHz
-    auto index =
-        juce::jlimit(0, fftSize / 2 - 1,
-                     static_cast<int>(freq / (static_cast<float>(sr) /
-                                              static_cast<float>(fftSize))));
-
-    // Find the magnitude
-    auto level = fftData[index];
-
-    // Convert to decibels with normalization and limiting
-    level =
-        juce::jmax(minDb, juce::Decibels::gainToDecibels(level) -
-                              juce::Decibels::gainToDecibels((float)fftSize));
-    level = juce::jmap(level, minDb, maxDb, 0.0f, 1.0f);
-
-    // Map to scopeData
-    scopeData[i] = level;
-  }
+void CustomReverbAudioProcessor::setSpectrumAnalyzerActive(
+    bool shouldBeActive) {
+  if (shouldBeActive)
+    getSpectrumAnalyzerWorker().start();
+  else if (analyzerWorker != nullptr)
+    analyzerWorker->stop();
+}
 
-  // Send the data to the spectrum analyzer if available (thread-safe)
-  auto *analyzer = spectrumAnalyzer.get();
-  if (analyzer != nullptr)
-    analyzer->updateSpectrum(scopeData, scopeSize);
+bool CustomReverbAudioProcessor::pullSpectrumFrame(
+    float *destination, int numBins, SpectrumAnalyzerWorker::View view,
+    float *inputDestination) {
+  if (analyzerWorker == nullptr)
+    return false;
+  return analyzerWorker->fetchLatestFrame(destination, numBins, view,
+                                          inputDestination);
 }
 
-void CustomReverbAudioProcessor::setSpectrumAnalyzer(
-    SpectrumAnalyzerComponent *analyzer) {
-  spectrumAnalyzer.set(analyzer);
+float CustomReverbAudioProcessor::getSpectrumCorrelation() const {
+  return analyzerWorker != nullptr ? analyzerWorker->getLatestCorrelation()
+                                   : 0.0f;
 }
 
 //==============================================================================
@@ -587,23 +956,74 @@ juce::AudioProcessorEditor *CustomReverbAudioProcessor::createEditor() {
 //==============================================================================
 void CustomReverbAudioProcessor::getStateInformation(
     juce::MemoryBlock &destData) {
-  // Create XML for saving plugin state
-  auto state = apvts.copyState();
-  std::unique_ptr<juce::XmlElement> xml(state.createXml());
-  copyXmlToBinary(*xml, destData);
+  // Fixed-layout binary chunk straight from the raw values - no ValueTree
+  // copy and no XML formatting
+  float values[numParameters];
+  for (int i = 0; i < numParameters; ++i)
+    values[i] = rawParameters[i]->load(std::memory_order_relaxed);
+
+  // The morph pad overrides the parameters while enabled, so it is part of
+  // the sound too
+  static_assert(numMorphCorners == ParameterState::MorphPadState::numCorners,
+                "The chunk stores one preset per morph pad corner");
+  ParameterState::MorphPadState morphPad;
+  morphPad.enabled = isMorphPadEnabled();
+  morphPad.x = morphX.load();
+  morphPad.y = morphY.load();
+  for (int corner = 0; corner < numMorphCorners; ++corner)
+    morphPad.cornerPresets[corner] =
+        static_cast<std::uint8_t>(getMorphPreset(corner));
+
+  destData.setSize(ParameterState::getEncodedSize(numParameters));
+  ParameterState::encode(parameterIDHashes, values, numParameters, morphPad,
+                         destData.getData());
 }
 
 void CustomReverbAudioProcessor::setStateInformation(const void *data,
                                                      int sizeInBytes) {
-  // Restore plugin state from XML
+  if (sizeInBytes <= 0)
+    return;
+
+  // Binary chunk: only the parameters it contains change; the parameter
+  // listeners flag them as usual
+  if (ParameterState::isBinaryState(data, static_cast<size_t>(sizeInBytes))) {
+    float values[numParameters] = {};
+    bool found[numParameters] = {};
+    if (ParameterState::decode(data, static_cast<size_t>(sizeInBytes),
+                               parameterIDHashes, numParameters, values,
+                               found) < 0)
+      return;
+
+    for (int i = 0; i < numParameters; ++i) {
+      if (!found[i] || !std::isfinite(values[i]))
+        continue;
+      parameters[i]->setValueNotifyingHost(
+          parameters[i]->convertTo0to1(values[i]));
+    }
+
+    // Chunks from before the morph pad leave it as it is
+    ParameterState::MorphPadState morphPad;
+    if (ParameterState::decodeMorphPad(
+            data, static_cast<size_t>(sizeInBytes), morphPad)) {
+      int corners[numMorphCorners];
+      std::copy_n(morphPad.cornerPresets, numMorphCorners, corners);
+      setMorphPresets(corners, numMorphCorners);
+      if (std::isfinite(morphPad.x) && std::isfinite(morphPad.y))
+        setMorphPosition(morphPad.x, morphPad.y);
+      setMorphPadEnabled(morphPad.enabled);
+    }
+    return;
+  }
+
+  // Sessions saved by older versions: restore plugin state from XML
   std::unique_ptr<juce::XmlElement> xmlState(
       getXmlFromBinary(data, sizeInBytes));
 
   if (xmlState.get() != nullptr &&
       xmlState->hasTagName(apvts.state.getType())) {
+    // The parameter listeners flag whatever changed; the audio thread
+    // adopts it at its next block
     apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
-    updateReverbParameters();
-    updateHighFreqParameters();
   }
 }
 
@@ -11,12 +11,9 @@
 #pragma once
 
 #include <JuceHeader.h>
-
-/**
- * Forward declaration for spectrum analyzer component
- * This allows the processor to send FFT data to the visual analyzer
- */
-class SpectrumAnalyzerComponent;
+#include "DspKernels.h"
+#include "ParameterState.h"
+#include "SpectrumAnalyzerWorker.h"
 
 //==============================================================================
 /**
@@ -31,12 +28,14 @@ class SpectrumAnalyzerComponent;
  * - Freeze mode for infinite sustain
  * - Real-time spectrum analysis and visualization
  *
- * Implements AudioProcessor for audio handling and ValueTreeState::Listener for
- * parameter updates
+ * Parameter changes never touch DSP state directly. Whichever thread changes
+ * a parameter only flags it (one atomic OR); at the start of each block the
+ * audio thread derives the flagged parameters into its own complete
+ * parameter snapshot, and a preset load hands over a whole precomputed
+ * snapshot in one atomic word. The audio thread therefore never sees a
+ * half-written parameter set, and no thread ever takes a lock or waits.
  */
-class CustomReverbAudioProcessor
-    : public juce::AudioProcessor,
-      public juce::AudioProcessorValueTreeState::Listener {
+class CustomReverbAudioProcessor : public juce::AudioProcessor {
 public:
   //==============================================================================
   /** Constructor - initializes parameters and DSP objects */
@@ -62,13 +61,13 @@ public:
    */
   void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
 
-  /** split the signal into low and high frequency bands */
-  void processCrossover(float leftIn, float rightIn, float &leftLow,
-                        float &leftHigh, float &rightLow, float &rightHigh);
+  /** split the signal into low and high frequency bands; the high band
+   * replaces the input in left/right */
+  void processCrossover(float *left, float *right, float *lowLeft,
+                        float *lowRight, int numSamples);
 
-  /** handle delay differently for high frequencies */
-  void processHighFreqDelay(float leftIn, float rightIn, float &leftOut,
-                            float &rightOut);
+  /** handle delay differently for high frequencies (in place) */
+  void processHighFreqDelay(float *left, float *right, int numSamples);
 
   //==============================================================================
   /** Creates the processor's GUI editor component */
@@ -94,13 +93,13 @@ public:
   double getTailLengthSeconds() const override;
 
   //==============================================================================
-  /** Returns the number of preset programs */
+  /** Returns the number of preset programs (the factory preset bank) */
   int getNumPrograms() override;
 
   /** Returns the index of the current program */
   int getCurrentProgram() override;
 
-  /** Sets the current program by index */
+  /** Loads a factory preset, morphing over getPresetMorphTime() */
   void setCurrentProgram(int index) override;
 
   /** Gets the name of a preset program by index */
@@ -110,29 +109,98 @@ public:
   void changeProgramName(int index, const juce::String &newName) override;
 
   //==============================================================================
-  /** Saves processor state to memory block for DAW session storage */
+  /** Saves processor state to memory block for DAW session storage, as a
+   * binary ParameterState chunk */
   void getStateInformation(juce::MemoryBlock &destData) override;
 
-  /** Restores processor state from memory block when DAW session is loaded */
+  /** Restores processor state from memory block when DAW session is loaded.
+   * Accepts binary chunks and the XML written by older versions. */
   void setStateInformation(const void *data, int sizeInBytes) override;
 
   //==============================================================================
-  /** Called when a parameter value changes - updates internal DSP state */
-  void parameterChanged(const juce::String &parameterID,
-                        float newValue) override;
+  /** Number of factory presets in the bank */
+  static constexpr int numPresets = 8;
+
+  /**
+   * Loads a factory preset (message thread). The request reaches the audio
+   * thread in one exchange; it then adopts the precomputed snapshot whole
+   * and morphs to it over
+   * morphSeconds (0 = the usual short parameter ramps). The parameters are
+   * updated too, so the host and editor follow.
+   */
+  void loadPreset(int index, float morphSeconds);
+
+  /** Morph time used when the host or editor changes program (any thread) */
+  void setPresetMorphTime(float seconds) {
+    presetMorphSeconds.store(juce::jmax(0.0f, seconds));
+  }
+  float getPresetMorphTime() const { return presetMorphSeconds.load(); }
+
+  //==============================================================================
+  /** Corners of the morph pad: bottom left, bottom right, top left, top
+   * right */
+  static constexpr int numMorphCorners = 4;
+
+  /**
+   * Assigns 2 to 4 bank presets to the morph pad (any thread). Two presets
+   * span the pad from left to right, a third one fills the top edge, four
+   * take one corner each.
+   */
+  void setMorphPresets(const int *presetIndices, int numPresetsToMorph);
+
+  /** Preset at one corner of the morph pad */
+  int getMorphPreset(int corner) const {
+    return morphCornerPresets[corner].load();
+  }
 
+  /**
+   * Moves the morph pad (any thread, e.g. from mouse drags or a controller
+   * at 100 Hz). x and y are 0-1. The audio thread interpolates the corner
+   * snapshots once per block; the parameters and the host are not involved.
+   */
+  void setMorphPosition(float x, float y) {
+    morphX.store(juce::jlimit(0.0f, 1.0f, x));
+    morphY.store(juce::jlimit(0.0f, 1.0f, y));
+  }
+  juce::Point<float> getMorphPosition() const {
+    return {morphX.load(), morphY.load()};
+  }
+
+  /** While enabled, the morph pad overrides the parameters (any thread) */
+  void setMorphPadEnabled(bool shouldBeEnabled) {
+    morphPadEnabled.store(shouldBeEnabled);
+  }
+  bool isMorphPadEnabled() const { return morphPadEnabled.load(); }
+
+  //==============================================================================
   /** Returns a reference to the parameter tree for editor access */
   juce::AudioProcessorValueTreeState &getAPVTS() { return apvts; }
 
-  /** Sets the spectrum analyzer component reference for FFT data visualization
-   */
-  void setSpectrumAnalyzer(SpectrumAnalyzerComponent *analyzer);
+  /** Starts or stops the background spectrum analysis. Editors switch it on
+   * while their analyzer is on screen. */
+  void setSpectrumAnalyzerActive(bool shouldBeActive);
+
+  /** Returns the background analyzer so editors can adjust its settings,
+   * creating it on first use. Message thread only. */
+  SpectrumAnalyzerWorker &getSpectrumAnalyzerWorker();
+
+  /** Copies one view (mid by default) of the latest spectrum frame (scopeSize
+   * normalised levels) of the output into destination, and of the dry input
+   * into inputDestination if given. Returns false if nothing new has been
+   * analysed since the previous call. Message thread only. */
+  bool pullSpectrumFrame(
+      float *destination, int numBins,
+      SpectrumAnalyzerWorker::View view = SpectrumAnalyzerWorker::View::mid,
+      float *inputDestination = nullptr);
+
+  /** L/R phase correlation (-1 to +1) of the last pulled frame */
+  float getSpectrumCorrelation() const;
 
   /** Constants for FFT analysis */
   enum {
-    fftOrder = 11,           // 2048 samples for FFT (2^11)
-    fftSize = 1 << fftOrder, // Size based on the order
-    scopeSize = 512          // Number of points to display in visualizer
+    fftOrder = SpectrumAnalyzerWorker::fftOrder, // 2048 samples for FFT (2^11)
+    fftSize = SpectrumAnalyzerWorker::fftSize,   // Size based on the order
+    scopeSize = SpectrumAnalyzerWorker::scopeSize // Points in visualizer
   };
 
   /** DSP Processing Constants */
@@ -159,9 +227,41 @@ private:
   static constexpr const char *highFreqMixParamID = "highFreqMix";
   static constexpr const char *harmDetuneAmountParamID = "harmDetuneAmount";
 
-  /** List of all parameter IDs for automated listener management */
+  /** List of all parameter IDs for automated listener management, in
+   * ParameterIndex order */
   static const std::vector<std::string> parameterIDs;
 
+  /** Position of each parameter in parameterIDs and the per-parameter
+   * tables below */
+  enum ParameterIndex {
+    roomSizeIndex,
+    dampingIndex,
+    wetLevelIndex,
+    dryLevelIndex,
+    widthIndex,
+    freezeModeIndex,
+    crossoverFreqIndex,
+    highFreqDelayIndex,
+    highFreqMixIndex,
+    harmDetuneAmountIndex,
+    numParameters
+  };
+
+  /**
+   * Forwards the changes of one parameter by index. One listener is
+   * registered per ID, so a change (on whatever thread the host automates
+   * from) involves no string comparisons.
+   */
+  struct ParameterListener
+      : public juce::AudioProcessorValueTreeState::Listener {
+    CustomReverbAudioProcessor *owner = nullptr;
+    ParameterIndex index = roomSizeIndex;
+
+    void parameterChanged(const juce::String &, float) override {
+      owner->publishParameterChange(index);
+    }
+  };
+
   //==============================================================================
   /**
    * Custom reverb parameters structure
@@ -197,9 +297,6 @@ private:
   juce::Reverb rightReverb;
   juce::Reverb::Parameters reverbParams;
 
-  /** Custom extended parameters for our enhanced reverb features */
-  CustomReverbParameters customParams;
-
   /** Parameter management tree - stores all adjustable parameters */
   juce::AudioProcessorValueTreeState apvts;
 
@@ -207,54 +304,217 @@ private:
    * AudioProcessorValueTreeState */
   juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
 
-  /** Updates the reverb parameters based on current values in the parameter
-   * tree */
-  void updateReverbParameters();
+  /**
+   * Everything the audio thread needs from the parameters: the plain
+   * parameter values, the custom and reverb parameter sets and the values
+   * derived from them. Only ever changed by one thread at a time, so the
+   * sets always belong together.
+   */
+  struct ParameterSnapshot {
+    float values[numParameters] = {}; // Plain values, ParameterIndex order
+    CustomReverbParameters custom;
+    juce::Reverb::Parameters reverb;
+    int highFreqDelaySamples = 1; // From custom.highFreqDelay
+    std::uint32_t reverbVersion = 0; // Bumped when reverb changes
+  };
 
-  //==============================================================================
-  // High Frequency Delay Implementation
+  /** A factory preset: its name and plain values in ParameterIndex order */
+  struct PresetDefinition {
+    const char *name;
+    float values[numParameters];
+  };
+  static const PresetDefinition presetDefinitions[numPresets];
+
+  /** Raw parameter values, the parameters and their ID hashes (for the
+   * state chunk), cached once at construction */
+  std::atomic<float> *rawParameters[numParameters] = {};
+  juce::RangedAudioParameter *parameters[numParameters] = {};
+  std::uint32_t parameterIDHashes[numParameters] = {};
+  ParameterListener parameterListeners[numParameters];
 
-  /** Delay buffers for high frequency content (separated for stereo channels)
+  /**
+   * Writer -> audio thread hand-over without locks. A change is already in
+   * the parameter's raw atomic, so writers (message thread, host automation
+   * threads, the audio thread itself) only set its bit. The audio thread
+   * takes every bit with one exchange at block start and derives the
+   * current raw values into its snapshot; a change that races the exchange
+   * is picked up at the next block.
    */
-  std::vector<float> highFreqDelayBufferL;
-  std::vector<float> highFreqDelayBufferR;
+  std::atomic<std::uint32_t> changedParameters{0};
+  static_assert(numParameters <= 32, "One bit per parameter");
+
+  /** Pending preset load: preset index + 1 in the low word and the morph
+   * time's float bits in the high word, 0 if none. One exchange hands over
+   * both. */
+  std::atomic<std::uint64_t> presetRequest{0};
+
+  /** The preset bank as complete snapshots, rebuilt whenever the sample rate
+   * changes (not while processBlock can run) and read-only otherwise */
+  ParameterSnapshot presetSnapshots[numPresets];
+  std::atomic<int> currentPreset{0};
+  std::atomic<float> presetMorphSeconds{0.0f};
+
+  /** The snapshot the audio thread processes with */
+  ParameterSnapshot activeParameters;
+  std::uint32_t appliedReverbVersion = 0; // Audio thread
 
-  /** Configuration for high frequency delay processing */
-  int highFreqBufferSize = 0;    // Size of the delay buffer in samples
-  int highFreqDelayReadPos = 0;  // Current read position in the delay buffer
-  int highFreqDelayWritePos = 0; // Current write position in the delay buffer
-  float highFreqDelayAmount = 0.0f; // Amount of delay to apply (0.0 to 1.0)
+  /** Flags one parameter as changed (wait-free, any thread) */
+  void publishParameterChange(ParameterIndex index);
 
-  /** Low pass filter coefficients and state for the crossover filter */
-  float lowpassCoeff = 0.0f;  // Filter coefficient (cutoff control)
-  float lowpassStateL = 0.0f; // Filter state for left channel
-  float lowpassStateR = 0.0f; // Filter state for right channel
+  /** Rebuilds the active snapshot and the preset bank for a sample rate (not
+   * while processBlock can run) */
+  void rebuildParameterSnapshots(float sampleRate);
+
+  /** Sets one plain value in a snapshot and derives what depends on it
+   * @return false if the snapshot already held that value */
+  static bool setSnapshotParameter(ParameterSnapshot &snapshot,
+                                   ParameterIndex index, float value);
+
+  /** Recomputes the fields derived from one plain value of a snapshot */
+  static void deriveSnapshotParameter(ParameterSnapshot &snapshot,
+                                      ParameterIndex index);
+
+  /** Takes over a requested preset and any changed parameters (audio
+   * thread) */
+  void adoptParameterSnapshot();
+
+  /** Passes reverbParams to both reverb processors */
+  void updateReverbParameters();
+
+  //==============================================================================
+  // Parameter Smoothing
+
+  /** Time over which smoothed parameters reach a new value */
+  static constexpr double smoothingTimeSec = 0.02;
+
+  /** Samples per crossover coefficient update while the frequency ramps */
+  static constexpr int coefficientSubBlockSize = 32;
+
+  /** Smoothed value types of the ramps in DspState */
+  using LinearSmoother = juce::SmoothedValue<float>;
+  using OctaveSmoother =
+      juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>;
+
+  /** Adopts the newest snapshot and jumps every ramp to it (not while
+   * processBlock can run) */
+  void resetParameterSmoothing(double sampleRate);
+
+  /** Changes how long the smoothed values take to reach their targets
+   * without moving them (audio thread) */
+  void setRampLength(double seconds);
+  double rampLengthSec = smoothingTimeSec;
+
+  /** Preset morph in progress: the reverb moves from start to target at
+   * block rate, and the reverb's own smoothing hides the steps (audio
+   * thread) */
+  juce::Reverb::Parameters morphStartReverb;
+  juce::Reverb::Parameters morphTargetReverb;
+  int morphLengthSamples = 0;
+  int morphSamplesRemaining = 0;
+
+  /** Moves a preset morph on by one block */
+  void advancePresetMorph(int numSamples);
+
+  /** Morph pad settings (any thread) */
+  std::atomic<int> morphCornerPresets[numMorphCorners];
+  std::atomic<float> morphX{0.5f};
+  std::atomic<float> morphY{0.5f};
+  std::atomic<bool> morphPadEnabled{false};
+
+  /** Morph pad state (audio thread). morphSnapshot holds the interpolated
+   * values, so only the ones that moved are derived again. */
+  ParameterSnapshot morphSnapshot;
+  float appliedMorphX = 0.0f;
+  float appliedMorphY = 0.0f;
+  int appliedMorphCorners[numMorphCorners] = {};
+  std::uint32_t appliedMorphReverbVersion = 0;
+  bool morphPadApplied = false;
+  bool parameterSnapshotOverridden = false; // Reapply when the pad is off
+
+  /** Interpolates the corner presets for the pad position and applies the
+   * result (audio thread, once per block) */
+  void applyMorphPad();
 
   //==============================================================================
-  // Harmonic Detuning Implementation
+  // Realtime DSP State
 
   /** Maximum size of harmonic detuning delay buffer */
   static const int maxHarmonicFilterSize = 50;
 
-  /** Buffers for storing audio for harmonic detuning effect */
-  std::vector<float>
-      oddHarmonicBufferL; // Buffer for odd harmonics (left channel)
-  std::vector<float>
-      evenHarmonicBufferR; // Buffer for even harmonics (right channel)
+  /**
+   * Everything the audio thread reads or writes per sample, packed together
+   * and aligned to a cache line, so a block touches a few adjacent lines of
+   * each instance instead of fields scattered between the JUCE bookkeeping
+   * and the analyzer. Hottest fields first.
+   */
+  struct alignas(64) DspState {
+    /** Crossover filter: coefficient (derived from the crossover frequency)
+     * and per-channel state */
+    float lowpassCoeff = 0.0f;
+    float lowpassStateL = 0.0f;
+    float lowpassStateR = 0.0f;
+
+    /** High frequency delay ring: positions and delay time in samples */
+    int highFreqDelayReadPos = 0;
+    int highFreqDelayWritePos = 0;
+    int highFreqDelaySamples = 1;
+    int highFreqBufferSize = 0;
+
+    /** A new delay time is not jumped to: the read tap at the old delay
+     * fades out while the one at the new delay fades in. A target that
+     * arrives mid-fade waits for the fade to finish. */
+    int highFreqDelayTarget = 1;
+    int highFreqFadeFromSamples = 1;
+    int highFreqFadeLength = 1;
+    int highFreqFadeRemaining = 0;
+
+    /** Current positions in the harmonic detuning buffers */
+    int oddHarmonicPos = 0;
+    int evenHarmonicPos = 0;
+
+    /** Audio thread ramps towards the adopted snapshot, so large blocks do
+     * not click. Gains ramp linearly; the crossover frequency ramps
+     * exponentially (evenly in octaves). The reverb smooths its own gains
+     * internally. */
+    LinearSmoother highFreqMixSmoother;
+    LinearSmoother harmDetuneSmoother;
+    OctaveSmoother crossoverSmoother;
+
+    /** SIMD kernels for this CPU, resolved in prepareToPlay */
+    const DspKernels::KernelTable *kernels = &DspKernels::getBestKernels();
+
+    /** Spectrum analyzer fed by the audio thread; null until an editor first
+     * asks for it */
+    std::atomic<SpectrumAnalyzerWorker *> analyzer{nullptr};
+
+    /** Custom extended parameters for our enhanced reverb features */
+    CustomReverbParameters customParams;
+
+    /** Delay buffers for high frequency content and the harmonic detuning
+     * buffers (odd harmonics left, even harmonics right) */
+    std::vector<float> highFreqDelayBufferL;
+    std::vector<float> highFreqDelayBufferR;
+    std::vector<float> oddHarmonicBufferL;
+    std::vector<float> evenHarmonicBufferR;
+  };
 
-  /** Current positions in harmonic buffers */
-  int oddHarmonicPos = 0;  // Position in the odd harmonics buffer
-  int evenHarmonicPos = 0; // Position in the even harmonics buffer
+  DspState dsp;
 
   //==============================================================================
   // DSP Processing Methods
 
   /** Processes the harmonic detuning effect on stereo channels */
-  void processHarmonicDetuning(float &leftSample, float &rightSample);
+  void processHarmonicDetuning(float &leftSample, float &rightSample,
+                               float amount);
 
-  /** Updates parameters for high frequency processing based on current values
-   */
-  void updateHighFreqParameters();
+  /** Runs the whole effect chain on at most bandBufferSize samples */
+  void processSection(float *left, float *right, int numSamples);
+
+  /** Per-section band buffers, sized in prepareToPlay so processBlock never
+   * allocates */
+  juce::AudioBuffer<float> lowFreqBuffer;
+  juce::AudioBuffer<float> delayedHighFreqBuffer; // Taps: new L/R, old L/R
+  juce::AudioBuffer<float> analyzerInputBuffer; // Dry input for the analyzer
 
   //==============================================================================
   // Helper Methods for Refactored Code
@@ -277,26 +537,17 @@ private:
   //==============================================================================
   // Spectrum Analysis Implementation
 
-  /** Thread-safe pointer to the spectrum analyzer component for visualization
+  /**
+   * Background analyzer - the audio thread only feeds its sample FIFO. Its
+   * frame rings and scope data are hundreds of kilobytes that only matter
+   * while an editor shows them, so they are allocated on first use instead
+   * of sitting in every instance (a session may run hundreds without ever
+   * opening an editor). Created under analyzerLock, then published through
+   * dsp.analyzer; it is never destroyed before the processor.
    */
-  juce::Atomic<SpectrumAnalyzerComponent *> spectrumAnalyzer{nullptr};
-
-  /** FFT analysis objects for spectrum visualization */
-  juce::dsp::FFT forwardFFT; // FFT processor
-  juce::dsp::WindowingFunction<float>
-      window; // Window function to reduce spectral leakage
-
-  /** FFT data storage and state */
-  float fifo[fftSize];        // Buffer for collecting samples for FFT
-  float fftData[2 * fftSize]; // Buffer for FFT results (complex values)
-  int fifoIndex = 0;          // Current position in the fifo buffer
-  bool nextFFTBlockReady =
-      false; // Flag indicating when FFT block is ready to process
-  float scopeData[scopeSize]; // Processed data ready for visualization
-
-  /** FFT processing methods */
-  void pushNextSampleIntoFifo(float sample); // Adds a sample to the FFT buffer
-  void drawNextFrameOfSpectrum();            // Triggers visualization update
+  std::unique_ptr<SpectrumAnalyzerWorker> analyzerWorker;
+  juce::CriticalSection analyzerLock;
+  double analyzerSampleRate = defaultSampleRate; // Under analyzerLock
 
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CustomReverbAudioProcessor)
 };
@@ -12,61 +12,165 @@
 
 // FFT Implementation
 
-void FFT::perform(std::complex<float>* data) {
-    // Bit-reversal permutation
-    int j1 = 0;
-    for (int i = 0; i < size - 1; i++) {
-        if (i < j1) {
-            std::swap(data[i], data[j1]);
+FFT::FFT(int order)
+    : order(order), size(1 << order), kernels(&DspKernels::getBestKernels()) {
+    const int half = size / 2;
+    
+    // Bit-reversal table for the full size; the half size table is the same
+    // shifted right by one bit
+    bitReverse.resize(size);
+    for (int i = 0; i < size; i++) {
+        int reversed = 0;
+        for (int bit = 0; bit < order; bit++) {
+            reversed |= ((i >> bit) & 1) << (order - 1 - bit);
         }
-        int m = size / 2;
-        while (m <= j1) {
-            j1 -= m;
-            m /= 2;
+        bitReverse[i] = reversed;
+    }
+    
+    // Per-stage twiddles stored contiguously: the stage with span m uses
+    // exp(-2 pi i j / m) for j < m / 2, starting at index m / 2 - 1
+    twiddleReal.resize(size - 1);
+    twiddleImag.resize(size - 1);
+    for (int m = 2; m <= size; m <<= 1) {
+        for (int j = 0; j < m / 2; j++) {
+            const double angle = -2.0 * M_PI * j / m;
+            twiddleReal[m / 2 - 1 + j] = (float)std::cos(angle);
+            twiddleImag[m / 2 - 1 + j] = (float)std::sin(angle);
         }
-        j1 += m;
     }
     
-    // Cooley-Tukey decimation-in-time algorithm
-    for (int stage = 1; stage <= order; stage++) {
-        int m = 1 << stage;
-        int m2 = m / 2;
-        int step = size / m;
+    // Twiddles that split the packed half size spectrum into the real one
+    postTwiddleReal.resize(half);
+    postTwiddleImag.resize(half);
+    for (int k = 0; k < half; k++) {
+        const double angle = -2.0 * M_PI * k / size;
+        postTwiddleReal[k] = (float)std::cos(angle);
+        postTwiddleImag[k] = (float)std::sin(angle);
+    }
+    
+    workReal.resize(size, 0.0f);
+    workImag.resize(size, 0.0f);
+    spectrumReal.resize(half + 1, 0.0f);
+    spectrumImag.resize(half + 1, 0.0f);
+    windowedInput.resize(size, 0.0f);
+    window.resize(size, 0.0f);
+    prepareWindow(size);
+}
+
+void FFT::performButterflies(float* re, float* im, int n) const {
+    // First stage: twiddle is always 1
+    for (int k = 0; k < n; k += 2) {
+        const float r1 = re[k + 1];
+        const float i1 = im[k + 1];
+        re[k + 1] = re[k] - r1;
+        im[k + 1] = im[k] - i1;
+        re[k] += r1;
+        im[k] += i1;
+    }
+    
+    // Cooley-Tukey decimation-in-time: every span reads the data and its
+    // twiddles contiguously, so each stage is one SIMD kernel call
+    for (int m = 4; m <= n; m <<= 1) {
+        const int halfSpan = m / 2;
+        kernels->fftButterflyStage(re, im, twiddleReal.data() + halfSpan - 1,
+                                   twiddleImag.data() + halfSpan - 1, n, halfSpan);
+    }
+}
+
+void FFT::perform(std::complex<float>* data) {
+    // Bit-reversal permutation into split real/imaginary form
+    for (int i = 0; i < size; i++) {
+        workReal[bitReverse[i]] = data[i].real();
+        workImag[bitReverse[i]] = data[i].imag();
+    }
+    
+    performButterflies(workReal.data(), workImag.data(), size);
+    
+    for (int i = 0; i < size; i++) {
+        data[i] = std::complex<float>(workReal[i], workImag[i]);
+    }
+}
+
+void FFT::performRealTransform(const float* samples) {
+    const int half = size / 2;
+    
+    // Pack even samples as real and odd samples as imaginary parts, already
+    // in bit-reversed order for the half size FFT
+    for (int i = 0; i < half; i++) {
+        const int target = bitReverse[i] >> 1;
+        workReal[target] = samples[2 * i];
+        workImag[target] = samples[2 * i + 1];
+    }
+    
+    performButterflies(workReal.data(), workImag.data(), half);
+    
+    // Separate the spectra of the even (E) and odd (O) samples and combine
+    // them: X[k] = E[k] + exp(-2 pi i k / size) * O[k]
+    spectrumReal[0] = workReal[0] + workImag[0];
+    spectrumImag[0] = 0.0f;
+    spectrumReal[half] = workReal[0] - workImag[0];
+    spectrumImag[half] = 0.0f;
+    
+    for (int k = 1; k < half; k++) {
+        const float zr = workReal[k];
+        const float zi = workImag[k];
+        const float mr = workReal[half - k];
+        const float mi = workImag[half - k];
         
-        for (int k = 0; k < size; k += m) {
-            for (int j2 = 0; j2 < m2; j2++) {
-                std::complex<float> t = twiddles[j2 * step] * data[k + j2 + m2];
-                std::complex<float> u = data[k + j2];
-                data[k + j2] = u + t;
-                data[k + j2 + m2] = u - t;
-            }
-        }
+        const float evenReal = 0.5f * (zr + mr);
+        const float evenImag = 0.5f * (zi - mi);
+        const float oddReal = 0.5f * (zi + mi);
+        const float oddImag = -0.5f * (zr - mr);
+        
+        const float wr = postTwiddleReal[k];
+        const float wi = postTwiddleImag[k];
+        spectrumReal[k] = evenReal + wr * oddReal - wi * oddImag;
+        spectrumImag[k] = evenImag + wr * oddImag + wi * oddReal;
+    }
+}
+
+void FFT::performRealForward(const float* input, std::complex<float>* output) {
+    performRealTransform(input);
+    
+    for (int k = 0; k <= size / 2; k++) {
+        output[k] = std::complex<float>(spectrumReal[k], spectrumImag[k]);
+    }
+}
+
+void FFT::prepareWindow(int numSamples) {
+    if (numSamples == windowLength) {
+        return;
+    }
+    
+    // Hann window over the analysed samples
+    windowLength = numSamples;
+    const int denominator = std::max(1, numSamples - 1);
+    for (int i = 0; i < numSamples; i++) {
+        window[i] = (float)(0.5 * (1.0 - std::cos(2.0 * M_PI * i / denominator)));
     }
 }
 
 void FFT::calculateMagnitudeSpectrum(const float* input, float* output, int numSamples) {
-    // Copy input data to complex array and apply window
-    std::vector<std::complex<float>> fftData(size);
+    numSamples = std::min(numSamples, size);
+    prepareWindow(numSamples);
     
     // Apply Hann window
-    for (int i = 0; i < numSamples && i < size; i++) {
-        float window = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (numSamples - 1)));
-        fftData[i] = std::complex<float>(input[i] * window, 0.0f);
+    for (int i = 0; i < numSamples; i++) {
+        windowedInput[i] = input[i] * window[i];
     }
     
     // Zero padding if needed
-    for (int i = numSamples; i < size; i++) {
-        fftData[i] = std::complex<float>(0.0f, 0.0f);
-    }
+    std::fill(windowedInput.begin() + numSamples, windowedInput.end(), 0.0f);
     
     // Perform FFT
-    perform(fftData.data());
+    performRealTransform(windowedInput.data());
     
     // Calculate magnitude spectrum
+    const float scale = 1.0f / (float)(size / 2);
     for (int i = 0; i < size / 2; i++) {
-        float real = fftData[i].real();
-        float imag = fftData[i].imag();
-        output[i] = std::sqrt(real * real + imag * imag) / (size / 2);
+        const float real = spectrumReal[i];
+        const float imag = spectrumImag[i];
+        output[i] = std::sqrt(real * real + imag * imag) * scale;
     }
 }
 
@@ -109,20 +213,27 @@ void SpectrumAnalyzer::update() {
                            smoothingCoefficient * (targetSpectrumValues[i] - previousSpectrumValues[i]);
     }
     
-    // Update animation
-    updateAnimation();
+    // Step the wave by the wall-clock time since the last update, so it
+    // moves at the same speed however often the caller redraws
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedSeconds = std::chrono::duration<double>(now - lastUpdateTime).count();
+    lastUpdateTime = now;
+    
+    wavePhysics.advance(spectrumValues.data(), elapsedSeconds);
 }
 
-void SpectrumAnalyzer::draw(std::vector<std::string>& buffer, int width, int height) {
-    // Clear the buffer
-    buffer.clear();
-    buffer.resize(height, std::string(width, ' '));
+void SpectrumAnalyzer::draw(TerminalRenderer& terminal) {
+    const int width = terminal.getWidth();
+    const int height = terminal.getHeight();
+    
+    // Every frame starts from blank cells; the renderer works out what changed
+    terminal.clear();
     
     // Draw grid lines
     for (int i = 0; i < height; ++i) {
         for (int j = 0; j < width; ++j) {
             if (i == height - 1 || j == 0) {
-                buffer[i][j] = '+';
+                terminal.setCell(j, i, '+');
             }
         }
     }
@@ -135,20 +246,18 @@ void SpectrumAnalyzer::draw(std::vector<std::string>& buffer, int width, int hei
         int pos = labelPositions[i];
         if (pos < width - 4) {
             for (int j = 0; j < strlen(labels[i]); ++j) {
-                if (pos + j < width) {
-                    buffer[height - 1][pos + j] = labels[i][j];
-                }
+                terminal.setCell(pos + j, height - 1, labels[i][j]);
             }
         }
     }
     
     // Draw the spectrum based on animation mode
     if (animationMode == 0) {  // Wave mode
-        drawWaveMode(buffer, width, height);
+        drawWaveMode(terminal);
     } else if (animationMode == 1) {  // Bar mode
-        drawBarMode(buffer, width, height);
+        drawBarMode(terminal);
     } else {  // Particle mode
-        drawParticleMode(buffer, width, height);
+        drawParticleMode(terminal);
     }
 }
 
@@ -162,41 +271,11 @@ void SpectrumAnalyzer::setColorScheme(int scheme) {
 
 // Private methods
 
-void SpectrumAnalyzer::updateAnimation() {
-    // Update wave targets based on spectrum values
-    for (int i = 0; i < waveTargets.size(); ++i) {
-        waveTargets[i] = spectrumValues[i];
-    }
-    
-    // Apply spring forces to each point
-    for (int i = 0; i < wavePoints.size(); ++i) {
-        // Spring force towards target
-        float force = tension * (waveTargets[i] - wavePoints[i]);
-        waveVelocities[i] += force;
-        
-        // Apply velocity to position
-        wavePoints[i] += waveVelocities[i] * animationSpeed;
-        
-        // Apply damping
-        waveVelocities[i] *= damping;
-    }
+void SpectrumAnalyzer::drawWaveMode(TerminalRenderer& terminal) {
+    const int width = terminal.getWidth();
+    const int height = terminal.getHeight();
+    const float* wavePoints = wavePhysics.getPoints();
     
-    // Apply spreading between adjacent points for fluid behavior
-    std::vector<float> spreadForces(wavePoints.size(), 0.0f);
-    
-    for (int i = 1; i < wavePoints.size() - 1; ++i) {
-        float leftDiff = wavePoints[i-1] - wavePoints[i];
-        float rightDiff = wavePoints[i+1] - wavePoints[i];
-        spreadForces[i] = spreadFactor * (leftDiff + rightDiff);
-    }
-    
-    // Apply spread forces
-    for (int i = 1; i < wavePoints.size() - 1; ++i) {
-        waveVelocities[i] += spreadForces[i];
-    }
-}
-
-void SpectrumAnalyzer::drawWaveMode(std::vector<std::string>& buffer, int width, int height) {
     for (int i = 0; i < scopeSize; ++i) {
         int x = width * i / scopeSize;
         if (x < width) {
@@ -204,38 +283,46 @@ void SpectrumAnalyzer::drawWaveMode(std::vector<std::string>& buffer, int width,
             yWave = std::max(0, std::min(yWave, height - 2));
             
             // Draw wave point (using simple characters for terminal compatibility)
-            buffer[yWave][x] = '#'; // Heavy character for wave crest
+            terminal.setCell(x, yWave, '#'); // Heavy character for wave crest
             
             // Fill area below wave for solid appearance
             for (int y = yWave + 1; y < height - 1; ++y) {
-                buffer[y][x] = '.'; // Light character for fill
+                terminal.setCell(x, y, '.'); // Light character for fill
             }
         }
     }
 }
 
-void SpectrumAnalyzer::drawBarMode(std::vector<std::string>& buffer, int width, int height) {
-    const int numBars = std::min(width - 1, (int)wavePoints.size());
+void SpectrumAnalyzer::drawBarMode(TerminalRenderer& terminal) {
+    const int width = terminal.getWidth();
+    const int height = terminal.getHeight();
+    const float* wavePoints = wavePhysics.getPoints();
+    const int numWavePoints = wavePhysics.getNumPoints();
+    const int numBars = std::min(width - 1, numWavePoints);
     
     for (int i = 0; i < numBars; ++i) {
         int x = i + 1; // Start from column 1 (0 is border)
         if (x < width) {
-            int barHeight = (int)((height - 2) * wavePoints[i * wavePoints.size() / numBars]);
+            int barHeight = (int)((height - 2) * wavePoints[i * numWavePoints / numBars]);
             barHeight = std::max(0, std::min(barHeight, height - 2));
             
             // Draw the bar
             for (int y = height - 2; y > height - 2 - barHeight; --y) {
-                buffer[y][x] = '|'; // Simple character for bars
+                terminal.setCell(x, y, '|'); // Simple character for bars
             }
         }
     }
 }
 
-void SpectrumAnalyzer::drawParticleMode(std::vector<std::string>& buffer, int width, int height) {
-    const int numPoints = std::min(width - 1, (int)wavePoints.size());
+void SpectrumAnalyzer::drawParticleMode(TerminalRenderer& terminal) {
+    const int width = terminal.getWidth();
+    const int height = terminal.getHeight();
+    const float* wavePoints = wavePhysics.getPoints();
+    const int numWavePoints = wavePhysics.getNumPoints();
+    const int numPoints = std::min(width - 1, numWavePoints);
     
     for (int i = 0; i < numPoints; ++i) {
-        float level = wavePoints[i * wavePoints.size() / numPoints];
+        float level = wavePoints[i * numWavePoints / numPoints];
         
         // Only draw particles for frequencies with some energy
         if (level > 0.05f) {
@@ -247,7 +334,7 @@ void SpectrumAnalyzer::drawParticleMode(std::vector<std::string>& buffer, int wi
                 int y = height - 2 - (int)((height - 2) * level * (0.5f + 0.5f * random() / RAND_MAX));
                 
                 if (x < width && y >= 0 && y < height - 1) {
-                    buffer[y][x] = '*'; // Asterisk for particles
+                    terminal.setCell(x, y, '*'); // Asterisk for particles
                 }
             }
         }
@@ -35,6 +35,11 @@
 #include <memory>
 #include <complex>
 #include <cstring>
+#include <chrono>
+
+#include "DspKernels.h"
+#include "TerminalRenderer.h"
+#include "WavePhysics.h"
 
 // Define M_PI for Windows if it's not defined
 #ifndef M_PI
@@ -47,28 +52,37 @@
  * A lightweight FFT implementation for real-time audio spectrum analysis.
  * This class handles the conversion from time-domain audio samples to
  * frequency-domain spectral data for visualization.
+ *
+ * Audio input is real, so a size N transform is computed as an N/2 point
+ * complex FFT of the even/odd samples packed as real/imaginary parts,
+ * followed by a post-twiddle pass that separates the two spectra. The
+ * butterflies work on split real/imaginary arrays with contiguous per-stage
+ * twiddle tables; the stages run through the SIMD kernel selected for this
+ * CPU (see DspKernels.h). Bit-reversal indices, twiddles and the analysis
+ * window are computed once, and all scratch memory is owned by the object -
+ * nothing is allocated per frame.
  */
 class FFT {
 public:
     /**
      * Construct an FFT processor with the specified order
-     * @param order The FFT order (size will be 2^order)
-     */
-    FFT(int order) : order(order), size(1 << order) {
-        // Pre-compute twiddle factors
-        twiddles.resize(size / 2);
-        for (int i = 0; i < size / 2; i++) {
-            float angle = (float)(-2.0 * M_PI * (float)i / (float)size);
-            twiddles[i] = std::complex<float>(cos(angle), sin(angle));
-        }
-    }
+     * @param order The FFT order (size will be 2^order, minimum 4)
+     */
+    FFT(int order);
     
     /**
      * Perform in-place FFT on complex data
-     * @param data Complex data array to transform
+     * @param data Complex data array to transform (getSize() values)
      */
     void perform(std::complex<float>* data);
     
+    /**
+     * Perform an FFT of real data
+     * @param input Real input samples (getSize() values)
+     * @param output Non-negative frequency bins (getSize() / 2 + 1 values)
+     */
+    void performRealForward(const float* input, std::complex<float>* output);
+    
     /**
      * Calculate magnitude spectrum from time-domain input
      * @param input Input audio samples (time domain)
@@ -84,9 +98,40 @@ public:
     int getSize() const { return size; }
     
 private:
+    /**
+     * Runs the radix-2 butterfly stages over split real/imaginary data that
+     * is already in bit-reversed order
+     */
+    void performButterflies(float* re, float* im, int n) const;
+    
+    /**
+     * Real transform of size samples; leaves bins 0..size/2 in
+     * spectrumReal/spectrumImag
+     */
+    void performRealTransform(const float* samples);
+    
+    /** Recomputes the Hann window if the analysed length changes */
+    void prepareWindow(int numSamples);
+    
     int order;                              // FFT order (log2 of size)
     int size;                               // FFT size (2^order)
-    std::vector<std::complex<float>> twiddles;  // Pre-computed twiddle factors
+    const DspKernels::KernelTable* kernels; // Butterfly implementation
+    
+    std::vector<int> bitReverse;            // Bit-reversed index of each position
+    std::vector<float> twiddleReal;         // Twiddles of the stage with span m
+    std::vector<float> twiddleImag;         // start at index m / 2 - 1
+    std::vector<float> postTwiddleReal;     // exp(-2 pi i k / size), k < size / 2
+    std::vector<float> postTwiddleImag;
+    
+    std::vector<float> window;              // Hann window for windowLength samples
+    int windowLength = 0;
+    
+    // Preallocated scratch
+    std::vector<float> workReal;            // Butterfly input/output
+    std::vector<float> workImag;
+    std::vector<float> spectrumReal;        // Real transform result
+    std::vector<float> spectrumImag;
+    std::vector<float> windowedInput;       // Windowed, zero padded samples
 };
 
 // Forward declaration
@@ -104,7 +149,7 @@ public:
     /**
      * Constructor - initializes the spectrum analyzer with default settings
      */
-    SpectrumAnalyzer() : fft(11), random(std::random_device()()) {
+    SpectrumAnalyzer() : fft(11), wavePhysics(512), random(std::random_device()()) {
         fftSize = 1 << 11;  // 2048 samples
         scopeSize = 512;    // Display resolution
         
@@ -115,21 +160,12 @@ public:
         fftData.resize(fftSize, 0.0f);
         scopeData.resize(scopeSize, 0.0f);
         
-        // Initialize wave animation data
-        wavePoints.resize(scopeSize, 0.0f);
-        waveVelocities.resize(scopeSize, 0.0f);
-        waveTargets.resize(scopeSize, 0.0f);
-        
-        // Set default animation properties
+        // Set default animation properties (the wave physics uses
+        // WavePhysics::Settings defaults)
         smoothingCoefficient = 0.2f;
-        animationSpeed = 0.05f;
         animationMode = 0;  // Wave mode
         colorScheme = 0;    // Blue/Cyan
-        
-        // Set fluid dynamics parameters
-        damping = 0.97f;
-        tension = 0.025f;
-        spreadFactor = 0.2f;
+        lastUpdateTime = std::chrono::steady_clock::now();
         
         // Set up FIFO for input data
         fifo.resize(fftSize, 0.0f);
@@ -150,12 +186,11 @@ public:
     void update();
     
     /**
-     * Draw the spectrum to a character buffer (for terminal display)
-     * @param buffer The string buffer to render to
-     * @param width Display width in characters
-     * @param height Display height in characters
+     * Draw the spectrum into a terminal's back buffer. Only the drawing
+     * happens here - call terminal.present() to send the changed cells.
+     * @param terminal The renderer to draw into; its size is the display size
      */
-    void draw(std::vector<std::string>& buffer, int width, int height);
+    void draw(TerminalRenderer& terminal);
     
     /**
      * Set the animation mode
@@ -187,25 +222,19 @@ public:
     
 private:
     /**
-     * Update the fluid wave animation
-     * Uses simplified physics to create natural-looking wave motion
+     * Draw wave animation mode to the terminal's back buffer
      */
-    void updateAnimation();
+    void drawWaveMode(TerminalRenderer& terminal);
     
     /**
-     * Draw wave animation mode to character buffer
+     * Draw bar animation mode to the terminal's back buffer
      */
-    void drawWaveMode(std::vector<std::string>& buffer, int width, int height);
+    void drawBarMode(TerminalRenderer& terminal);
     
     /**
-     * Draw bar animation mode to character buffer
+     * Draw particle animation mode to the terminal's back buffer
      */
-    void drawBarMode(std::vector<std::string>& buffer, int width, int height);
-    
-    /**
-     * Draw particle animation mode to character buffer
-     */
-    void drawParticleMode(std::vector<std::string>& buffer, int width, int height);
+    void drawParticleMode(TerminalRenderer& terminal);
     
     // FFT implementation
     FFT fft;                    // FFT processor
@@ -220,21 +249,14 @@ private:
     std::vector<float> scopeData;               // Processed spectrum data
     
     // Wave animation data
-    std::vector<float> wavePoints;              // Current wave positions
-    std::vector<float> waveVelocities;          // Wave movement velocities
-    std::vector<float> waveTargets;             // Target positions for waves
+    WavePhysics wavePhysics;        // Fixed-timestep spring solver
+    std::chrono::steady_clock::time_point lastUpdateTime; // Drives wavePhysics
     
     // Animation properties
     float smoothingCoefficient;     // Controls smoothness between frames
-    float animationSpeed;           // Speed of animations
     int animationMode;              // Current animation mode
     int colorScheme;                // Current color scheme
     
-    // Fluid dynamics parameters
-    float damping;                  // How quickly motion slows down
-    float tension;                  // How strongly points pull toward targets
-    float spreadFactor;             // How much adjacent points influence each other
-    
     // Input FIFO
     std::vector<float> fifo;        // FIFO buffer for input samples
     int fifoIndex;                  // Current position in FIFO
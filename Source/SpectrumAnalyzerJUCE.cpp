@@ -11,6 +11,7 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "WavePhysics.h"
 
 // This file contains the JUCE-compatible implementation for the SpectrumAnalyzer component
 // It replaces our custom FFT implementation with JUCE's built-in FFT
@@ -35,35 +36,11 @@ namespace SpectrumAnalyzerAdapter {
         }
     }
     
-    // Apply fluid dynamics simulation to create animated wave effect
-    void applyFluidDynamics(float* points, float* velocities, const float* targets, 
-                            int size, float tension, float damping, float spreadFactor) {
-        // Create temporary buffer for spread forces
-        std::vector<float> spreadForces(size, 0.0f);
-        
-        // Apply spring force towards target
-        for (int i = 0; i < size; ++i) {
-            float force = tension * (targets[i] - points[i]);
-            velocities[i] += force;
-            
-            // Apply velocity to position
-            points[i] += velocities[i] * 0.05f; // Animation speed
-            
-            // Apply damping
-            velocities[i] *= damping;
-        }
-        
-        // Calculate spread forces between adjacent points
-        for (int i = 1; i < size - 1; ++i) {
-            float leftDiff = points[i-1] - points[i];
-            float rightDiff = points[i+1] - points[i];
-            spreadForces[i] = spreadFactor * (leftDiff + rightDiff);
-        }
-        
-        // Apply spread forces
-        for (int i = 1; i < size - 1; ++i) {
-            velocities[i] += spreadForces[i];
-        }
+    // Advance the shared wave solver by the time since the last frame. The
+    // solver steps at a fixed rate, so the motion does not depend on how
+    // often this is called.
+    int applyFluidDynamics(WavePhysics& physics, const float* targets, double elapsedSeconds) {
+        return physics.advance(targets, elapsedSeconds);
     }
     
     // Generate initial colors for the visualization based on scheme
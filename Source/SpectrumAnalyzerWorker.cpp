@@ -0,0 +1,426 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzerWorker.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzerWorker.h"
+
+//==============================================================================
+SpectrumAnalyzerWorker::SpectrumAnalyzerWorker()
+    : juce::Thread("ReverbWave Spectrum Analyzer"), forwardFFT(fftOrder) {
+  fifoBuffer.resize(numChannels * fifoCapacity, 0.0f);
+
+  juce::dsp::WindowingFunction<float>::fillWindowingTables(
+      windowTable, fftSize, juce::dsp::WindowingFunction<float>::hann, true);
+
+  for (auto &level : levels) {
+    for (auto &channel : level.history)
+      std::fill(channel, channel + fftSize, 0.0f);
+    for (auto &tap : level.scope)
+      for (auto &view : tap)
+        std::fill(view, view + scopeSize, 0.0f);
+  }
+
+  // One FIFO segment at most, divided by the decimation of each level
+  for (int i = 0; i < numLevels - 1; ++i)
+    decimatedScratch[i].resize(numChannels * fifoCapacity / decimationFactor,
+                               0.0f);
+}
+
+SpectrumAnalyzerWorker::~SpectrumAnalyzerWorker() { stop(); }
+
+void SpectrumAnalyzerWorker::prepare(double sampleRate) {
+  if (sampleRate > 0.0)
+    currentSampleRate.store(sampleRate);
+}
+
+void SpectrumAnalyzerWorker::start() {
+  if (isThreadRunning())
+    return;
+
+  // The thread is stopped, so we are the only consumer: throw away anything
+  // left over from the previous session before the display picks it up
+  abstractFifo.finishedRead(abstractFifo.getNumReady());
+
+  for (auto &level : levels)
+    resetLevel(level);
+  appliedResolution = resolution.load();
+
+  sumLeftRight = sumLeftSquared = sumRightSquared = 0.0;
+
+  active.store(true, std::memory_order_release);
+  startThread(juce::Thread::Priority::low);
+}
+
+void SpectrumAnalyzerWorker::stop() {
+  active.store(false, std::memory_order_release);
+  stopThread(1000);
+}
+
+void SpectrumAnalyzerWorker::setOverlap(Overlap newOverlap) noexcept {
+  switch (newOverlap) {
+  case Overlap::half:
+    hopSize.store(fftSize / 2);
+    break;
+  case Overlap::threeQuarters:
+    hopSize.store(fftSize / 4);
+    break;
+  case Overlap::sevenEighths:
+    hopSize.store(fftSize / 8);
+    break;
+  }
+}
+
+SpectrumAnalyzerWorker::Overlap
+SpectrumAnalyzerWorker::getOverlap() const noexcept {
+  const int hop = hopSize.load();
+  if (hop >= fftSize / 2)
+    return Overlap::half;
+  return hop >= fftSize / 4 ? Overlap::threeQuarters : Overlap::sevenEighths;
+}
+
+void SpectrumAnalyzerWorker::setTargetFrameRate(
+    double framesPerSecond) noexcept {
+  wakeupIntervalMs.store(
+      juce::jlimit(1, 100, juce::roundToInt(1000.0 / framesPerSecond)));
+}
+
+bool SpectrumAnalyzerWorker::fetchLatestFrame(
+    float *destination, int numBins, View view,
+    float *inputDestination) noexcept {
+  jassert(numBins == scopeSize);
+
+  if (!spectrumFrames.fetch())
+    return false;
+
+  const auto &frame = spectrumFrames.getReadBuffer();
+  const int numToCopy = juce::jmin(numBins, (int)scopeSize);
+
+  const auto *scope = frame.scope[(int)Tap::output][(int)view];
+  std::copy(scope, scope + numToCopy, destination);
+
+  if (inputDestination != nullptr) {
+    const auto *inputScope = frame.scope[(int)Tap::input][(int)view];
+    std::copy(inputScope, inputScope + numToCopy, inputDestination);
+  }
+
+  return true;
+}
+
+//==============================================================================
+void SpectrumAnalyzerWorker::pushSamples(const float *outputLeft,
+                                         const float *outputRight,
+                                         const float *inputLeft,
+                                         const float *inputRight,
+                                         int numSamples) noexcept {
+  int start1, size1, start2, size2;
+  abstractFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+  // The interleaving copy is the only per-sample work on the audio thread.
+  // Both taps share one frame, so they can never drift apart.
+  auto interleave = [=](int source, int start, int size) {
+    float *dest = fifoBuffer.data() + numChannels * start;
+    for (int i = 0; i < size; ++i, dest += numChannels) {
+      dest[0] = outputLeft[source + i];
+      dest[1] = outputRight[source + i];
+      dest[2] = inputLeft[source + i];
+      dest[3] = inputRight[source + i];
+    }
+  };
+
+  interleave(0, start1, size1);
+  interleave(size1, start2, size2);
+
+  abstractFifo.finishedWrite(size1 + size2);
+}
+
+void SpectrumAnalyzerWorker::run() {
+  while (!threadShouldExit()) {
+    const auto sampleRate = currentSampleRate.load();
+    if (sampleRate != preparedSampleRate)
+      prepareLevels(sampleRate);
+
+    // Decimated levels were not fed while switched off, so they restart
+    // from silence instead of analysing a stale window
+    const auto newResolution = resolution.load();
+    if (newResolution != appliedResolution) {
+      for (int i = 1; i < numLevels; ++i)
+        resetLevel(levels[i]);
+      appliedResolution = newResolution;
+    }
+
+    // Frames superseded within one wakeup would never be displayed, so only
+    // the newest window of each level is analysed
+    if (drainFifo())
+      drawNextFrameOfSpectrum();
+
+    wait(wakeupIntervalMs.load());
+  }
+}
+
+void SpectrumAnalyzerWorker::prepareLevels(double sampleRate) {
+  preparedSampleRate = sampleRate;
+
+  // Correlation integrates over roughly the last 300ms
+  correlationDecay = std::exp(-1.0 / (0.3 * sampleRate));
+
+  // 4th order Butterworth as two biquads
+  const float butterworthQ[2] = {0.5412f, 1.3066f};
+
+  double levelRate = sampleRate;
+  for (int i = 0; i < numLevels; ++i) {
+    auto &level = levels[i];
+
+    if (i > 0) {
+      // Cut off inside the passband of the decimated signal (0.4 x its
+      // sample rate, i.e. 80% of its Nyquist frequency)
+      const double cutoff = 0.4 * levelRate / decimationFactor;
+      for (auto &channelFilters : level.antiAliasFilters) {
+        for (int stage = 0; stage < 2; ++stage) {
+          channelFilters[stage].coefficients =
+              juce::dsp::IIR::Coefficients<float>::makeLowPass(
+                  levelRate, (float)cutoff, butterworthQ[stage]);
+          channelFilters[stage].reset();
+        }
+      }
+      level.decimationPhase = 0;
+      levelRate /= decimationFactor;
+    }
+
+    level.binMap.build(levelRate, fftSize, scopeSize);
+  }
+
+  // Each band uses the level with the best time resolution that still gives
+  // it at least one whole bin; bands that none can resolve use the finest
+  // frequency resolution whose anti-alias passband covers them
+  for (int band = 0; band < scopeSize; ++band) {
+    const float centre = SpectrumBinMap::getBandCentreFrequency(band, scopeSize);
+
+    int source = 0;
+    double rate = sampleRate;
+    for (int i = 0; i < numLevels; ++i, rate /= decimationFactor) {
+      if (i > 0 && centre > 0.35 * rate)
+        break;
+
+      source = i;
+      if (levels[i].binMap.getNumBinsInBand(band) > 0)
+        break;
+    }
+
+    bandSourceLevel[band] = source;
+  }
+}
+
+bool SpectrumAnalyzerWorker::drainFifo() {
+  int start1, size1, start2, size2;
+  abstractFifo.prepareToRead(abstractFifo.getNumReady(), start1, size1, start2,
+                             size2);
+
+  writeSamples(fifoBuffer.data() + numChannels * start1, size1);
+  writeSamples(fifoBuffer.data() + numChannels * start2, size2);
+
+  abstractFifo.finishedRead(size1 + size2);
+
+  for (int i = 0; i < getNumActiveLevels(); ++i)
+    if (levels[i].hopCompleted)
+      return true;
+
+  return false;
+}
+
+void SpectrumAnalyzerWorker::resetLevel(AnalysisLevel &level) {
+  for (auto &channel : level.history)
+    std::fill(channel, channel + fftSize, 0.0f);
+  level.historyWritePos = 0;
+  level.samplesUntilNextHop = hopSize.load();
+  level.hopCompleted = false;
+
+  for (auto &channelFilters : level.antiAliasFilters)
+    for (auto &filter : channelFilters)
+      filter.reset();
+  level.decimationPhase = 0;
+
+  for (auto &tapScope : level.scope)
+    for (auto &viewScope : tapScope)
+      std::fill(viewScope, viewScope + scopeSize, 0.0f);
+}
+
+//==============================================================================
+void SpectrumAnalyzerWorker::writeSamples(const float *frames,
+                                          int numFrames) {
+  updateCorrelation(frames, numFrames);
+  writeToHistory(levels[0], frames, numFrames);
+
+  // Each level decimates the one above it
+  for (int i = 1; i < getNumActiveLevels(); ++i) {
+    float *decimated = decimatedScratch[i - 1].data();
+    numFrames = decimate(levels[i], frames, numFrames, decimated);
+    writeToHistory(levels[i], decimated, numFrames);
+    frames = decimated;
+  }
+}
+
+void SpectrumAnalyzerWorker::updateCorrelation(const float *frames,
+                                               int numFrames) {
+  // Leaky integrators of the correlation terms (output tap only)
+  const double decay = correlationDecay;
+  for (int i = 0; i < numFrames; ++i, frames += numChannels) {
+    const double left = frames[0];
+    const double right = frames[1];
+    sumLeftRight = sumLeftRight * decay + left * right;
+    sumLeftSquared = sumLeftSquared * decay + left * left;
+    sumRightSquared = sumRightSquared * decay + right * right;
+  }
+}
+
+int SpectrumAnalyzerWorker::decimate(AnalysisLevel &level, const float *input,
+                                     int numFrames, float *output) {
+  int numProduced = 0;
+  float filtered[numChannels];
+
+  for (int i = 0; i < numFrames; ++i, input += numChannels) {
+    for (int channel = 0; channel < numChannels; ++channel) {
+      auto &filters = level.antiAliasFilters[channel];
+      filtered[channel] =
+          filters[1].processSample(filters[0].processSample(input[channel]));
+    }
+
+    if (++level.decimationPhase == decimationFactor) {
+      level.decimationPhase = 0;
+      std::copy(filtered, filtered + numChannels,
+                output + numChannels * numProduced);
+      ++numProduced;
+    }
+  }
+
+  return numProduced;
+}
+
+void SpectrumAnalyzerWorker::writeToHistory(AnalysisLevel &level,
+                                            const float *frames,
+                                            int numFrames) {
+  while (numFrames > 0) {
+    // Copy up to the next hop boundary or the end of the ring, whichever is
+    // closer
+    const int num = juce::jmin(numFrames, level.samplesUntilNextHop,
+                               fftSize - level.historyWritePos);
+    for (int channel = 0; channel < numChannels; ++channel) {
+      float *dest = level.history[channel] + level.historyWritePos;
+      for (int i = 0; i < num; ++i)
+        dest[i] = frames[numChannels * i + channel];
+    }
+
+    level.historyWritePos = (level.historyWritePos + num) & (fftSize - 1);
+    level.samplesUntilNextHop -= num;
+    frames += numChannels * num;
+    numFrames -= num;
+
+    if (level.samplesUntilNextHop == 0) {
+      level.hopCompleted = true;
+      level.samplesUntilNextHop = hopSize.load();
+    }
+  }
+}
+
+void SpectrumAnalyzerWorker::windowLatestHistory(const AnalysisLevel &level,
+                                                 int numActiveTaps) {
+  // The ring always holds exactly one window; the oldest frame sits at the
+  // write position. Window both channels of each tap straight into its packed
+  // FFT input (left as the real part, right as the imaginary part).
+  const int writePos = level.historyWritePos;
+
+  for (int tap = 0; tap < numActiveTaps; ++tap) {
+    const float *left = level.history[2 * tap];
+    const float *right = level.history[2 * tap + 1];
+    auto *input = fftInput[tap];
+
+    for (int i = 0; i < fftSize; ++i) {
+      const int index = (writePos + i) & (fftSize - 1);
+      input[i] = {left[index] * windowTable[i], right[index] * windowTable[i]};
+    }
+  }
+}
+
+void SpectrumAnalyzerWorker::separateSpectra(int tap) {
+  // For z = l + i * r the spectra of the two real signals are
+  //   L[k] = (Z[k] + conj(Z[N - k])) / 2
+  //   R[k] = (Z[k] - conj(Z[N - k])) / 2i
+  // and mid/side follow linearly, so no further transforms are needed
+  const auto *spectrum = fftOutput[tap];
+  auto &tapMagnitudes = magnitudes[tap];
+
+  for (int k = 0; k < fftSize / 2; ++k) {
+    const auto z = spectrum[k];
+    const auto mirrored = std::conj(spectrum[(fftSize - k) & (fftSize - 1)]);
+
+    const auto left = 0.5f * (z + mirrored);
+    const auto right = juce::dsp::Complex<float>(0.0f, -0.5f) * (z - mirrored);
+
+    tapMagnitudes[(int)View::mid][k] = std::abs(0.5f * (left + right));
+    tapMagnitudes[(int)View::side][k] = std::abs(0.5f * (left - right));
+    tapMagnitudes[(int)View::left][k] = std::abs(left);
+    tapMagnitudes[(int)View::right][k] = std::abs(right);
+  }
+}
+
+void SpectrumAnalyzerWorker::analyseLevel(AnalysisLevel &level) {
+  // The input tap is only transformed while something displays it
+  const int numActiveTaps = inputTapEnabled.load() ? numTaps : 1;
+
+  // Apply windowing function to the newest fftSize frames of every tap
+  windowLatestHistory(level, numActiveTaps);
+
+  // Transform the taps as one batch with the same plan (one complex FFT per
+  // tap for both of its channels), then split the results
+  for (int tap = 0; tap < numActiveTaps; ++tap)
+    forwardFFT.perform(fftInput[tap], fftOutput[tap], false);
+
+  for (int tap = 0; tap < numActiveTaps; ++tap)
+    separateSpectra(tap);
+
+  // Map the bins onto the display bands (the table only changes with the
+  // sample rate, so this is just a lookup)
+  const auto bandAggregation = aggregation.load();
+  for (int tap = 0; tap < numActiveTaps; ++tap)
+    for (int view = 0; view < numViews; ++view)
+      level.binMap.process(magnitudes[tap][view], level.scope[tap][view],
+                           bandAggregation);
+
+  level.hopCompleted = false;
+}
+
+void SpectrumAnalyzerWorker::drawNextFrameOfSpectrum() {
+  const bool multiResolution = appliedResolution == Resolution::multi;
+
+  for (int i = 0; i < getNumActiveLevels(); ++i)
+    if (levels[i].hopCompleted)
+      analyseLevel(levels[i]);
+
+  // Stitch the levels on the shared log-frequency axis
+  auto &frame = spectrumFrames.getWriteBuffer();
+
+  for (int tap = 0; tap < numTaps; ++tap) {
+    for (int view = 0; view < numViews; ++view) {
+      auto *dest = frame.scope[tap][view];
+      if (multiResolution) {
+        for (int band = 0; band < scopeSize; ++band)
+          dest[band] = levels[bandSourceLevel[band]].scope[tap][view][band];
+      } else {
+        std::copy(levels[0].scope[tap][view],
+                  levels[0].scope[tap][view] + scopeSize, dest);
+      }
+    }
+  }
+
+  const double energy = std::sqrt(sumLeftSquared * sumRightSquared);
+  frame.correlation =
+      energy > 1.0e-12 ? static_cast<float>(sumLeftRight / energy) : 0.0f;
+
+  // Hand the complete frame to the editor - never blocks
+  spectrumFrames.publish();
+}
@@ -0,0 +1,284 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzerWorker.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Background spectrum analysis for the plugin editor.
+
+  The audio thread only writes interleaved frames (processed output L/R plus
+  the dry input L/R) into a wait-free single-producer / single-consumer FIFO.
+  A low priority worker thread drains that FIFO into a sliding analysis window
+  (a short-time Fourier transform with a configurable hop), runs the
+  windowing, FFT and dB mapping, and publishes the finished scope frames
+  through a lock-free triple buffer. Left and right are packed into the real
+  and imaginary parts of one complex FFT and separated afterwards, so the
+  left, right, mid and side spectra of a tap all come from a single
+  transform, and the input and output taps are transformed back to back with
+  one plan. A running phase correlation of the output is published alongside
+  them. In multi-resolution mode the same FFT also runs on copies of the
+  signal decimated by 4 and 16, and each display band is taken from the
+  shortest window that still resolves it, which approximates a constant-Q
+  analysis at three times the cost of one FFT. The editor pulls the latest
+  frame on its own timer, so no thread ever holds a pointer to a GUI
+  component. The worker only runs while an editor is open, so a plugin
+  instance without a visible GUI pays nothing beyond an atomic flag check.
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpectrumBinMap.h"
+#include "TripleBuffer.h"
+
+//==============================================================================
+/**
+ * SpectrumAnalyzerWorker
+ *
+ * Owns the analysis FIFO, the FFT buffers and the thread that processes them.
+ *
+ * Threading contract:
+ * - pushSamples() is called from the audio thread only (single producer)
+ * - the worker thread is the only consumer of the FIFO and the only
+ *   producer of spectrum frames
+ * - start()/stop()/prepare()/fetchLatestFrame() are called from the message
+ *   thread, which is the only consumer of spectrum frames
+ */
+class SpectrumAnalyzerWorker : private juce::Thread {
+public:
+  /** Constants for FFT analysis */
+  enum {
+    fftOrder = 11,           // 2048 samples for FFT (2^11)
+    fftSize = 1 << fftOrder, // Size based on the order
+    scopeSize = 512,         // Number of points to display in visualizer
+    fifoCapacity = 1 << 15   // ~0.7s of audio at 48kHz between worker wakeups
+  };
+
+  /** Which spectrum of the stereo signal to display */
+  enum class View {
+    mid,   // (L + R) / 2 - what a mono fold-down sounds like
+    side,  // (L - R) / 2 - the stereo width content
+    left,
+    right
+  };
+  static constexpr int numViews = 4;
+
+  /** Where the analysed signal is taken from */
+  enum class Tap {
+    output, // After the reverb, crossover and HF delay
+    input   // Dry input of the same block, for before/after comparison
+  };
+  static constexpr int numTaps = 2;
+
+  SpectrumAnalyzerWorker();
+  ~SpectrumAnalyzerWorker() override;
+
+  /** Updates the sample rate used to map FFT bins to display frequencies */
+  void prepare(double sampleRate);
+
+  /**
+   * Writes the output and dry input of a block into the analysis FIFO as
+   * interleaved frames (audio thread, wait-free). Frames that do not fit are
+   * dropped - the display simply skips them.
+   */
+  void pushSamples(const float *outputLeft, const float *outputRight,
+                   const float *inputLeft, const float *inputRight,
+                   int numSamples) noexcept;
+
+  /** Starts/stops the worker thread (message thread) */
+  void start();
+  void stop();
+
+  /** True while the worker is consuming samples; cheap enough for the audio
+   * thread to check every block */
+  bool isActive() const noexcept {
+    return active.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Copies one view of the newest complete spectrum frame into destination
+   * (message thread). Never blocks the worker. If inputDestination is given,
+   * the same view of the input tap is copied there from the same frame.
+   * @return false if no frame has been published since the last call
+   */
+  bool fetchLatestFrame(float *destination, int numBins,
+                        View view = View::mid,
+                        float *inputDestination = nullptr) noexcept;
+
+  /** Enables analysis of the input tap (any thread). Off by default, so the
+   * worker only runs the second transform while an overlay is shown. */
+  void setInputTapEnabled(bool shouldAnalyseInput) noexcept {
+    inputTapEnabled.store(shouldAnalyseInput);
+  }
+  bool isInputTapEnabled() const noexcept { return inputTapEnabled.load(); }
+
+  /** Phase correlation of the last fetched frame: +1 mono, 0 unrelated,
+   * -1 out of phase (message thread) */
+  float getLatestCorrelation() const noexcept {
+    return spectrumFrames.getReadBuffer().correlation;
+  }
+
+  /** Overlap between consecutive analysis windows. More overlap means better
+   * time resolution (a new frame every fftSize / 8 samples at 87.5%) at the
+   * cost of more FFTs per second. */
+  enum class Overlap {
+    half,          // hop = fftSize / 2
+    threeQuarters, // hop = fftSize / 4
+    sevenEighths   // hop = fftSize / 8
+  };
+
+  /** Sets the STFT hop (any thread) */
+  void setOverlap(Overlap newOverlap) noexcept;
+  Overlap getOverlap() const noexcept;
+
+  /** Sets how often the worker wakes up to publish frames (any thread). The
+   * worker analyses at most one frame per wakeup, so this caps the analysis
+   * CPU independently of the overlap. */
+  void setTargetFrameRate(double framesPerSecond) noexcept;
+
+  /** Single FFT, or the FFT repeated on signals decimated by 4 and 16 so that
+   * bands below a few hundred Hz get up to 16x finer frequency resolution.
+   * Costs three fftSize FFTs instead of one 16x longer FFT. */
+  enum class Resolution { single, multi };
+
+  /** Switches between single and multi-resolution analysis (any thread) */
+  void setResolution(Resolution newResolution) noexcept {
+    resolution.store(newResolution);
+  }
+  Resolution getResolution() const noexcept { return resolution.load(); }
+
+  /** Chooses how FFT bins are combined into display bands */
+  void setBandAggregation(SpectrumBinMap::Aggregation newAggregation) noexcept {
+    aggregation.store(newAggregation);
+  }
+
+  /** Sequence number of the frame returned by the last successful fetch */
+  std::uint64_t getLatestFrameSequence() const noexcept {
+    return spectrumFrames.getReadSequence();
+  }
+
+private:
+  /** Number of analysis levels and the decimation between neighbours */
+  static constexpr int numLevels = 3;
+  static constexpr int decimationFactor = 4;
+
+  /** Samples per FIFO frame: output L/R, then input L/R */
+  static constexpr int numChannels = 2 * numTaps;
+
+  /**
+   * One resolution of the STFT: a decimated copy of the input, its sliding
+   * analysis window and the display bands it produced last.
+   */
+  struct AnalysisLevel {
+    /** Anti-alias filters (4th order Butterworth per channel) applied before
+     * decimating the previous level's signal */
+    juce::dsp::IIR::Filter<float> antiAliasFilters[numChannels][2];
+    int decimationPhase = 0;
+
+    float history[numChannels][fftSize]; // Rings of the newest fftSize frames
+    int historyWritePos = 0;             // Next write position (= oldest)
+    int samplesUntilNextHop = fftSize / 4; // Countdown to the next frame
+    bool hopCompleted = false;             // New frame due at next analysis
+
+    SpectrumBinMap binMap; // Bins of this level -> display bands
+    float scope[numTaps][numViews][scopeSize]; // Band levels, newest frame
+  };
+
+  void run() override;
+
+  /** Rebuilds filters, bin maps and the band -> level table for a sample
+   * rate (worker thread; allocates) */
+  void prepareLevels(double sampleRate);
+
+  /** Drains everything the audio thread has written since the last wakeup
+   * @return true if at least one active level crossed a hop boundary */
+  bool drainFifo();
+
+  /** Clears a level's window, filters, hop countdown and scope */
+  void resetLevel(AnalysisLevel &level);
+
+  /** Levels fed and analysed in the applied resolution mode */
+  int getNumActiveLevels() const noexcept {
+    return appliedResolution == Resolution::multi ? numLevels : 1;
+  }
+
+  /** Feeds a block of full-rate interleaved frames to every active level */
+  void writeSamples(const float *frames, int numFrames);
+
+  /** Updates the running L/R correlation with full-rate frames */
+  void updateCorrelation(const float *frames, int numFrames);
+
+  /** Low-pass filters and decimates interleaved frames into the level's
+   * scratch buffer
+   * @return number of decimated frames produced */
+  int decimate(AnalysisLevel &level, const float *input, int numFrames,
+               float *output);
+
+  /** Appends interleaved frames to a level's sliding analysis window */
+  void writeToHistory(AnalysisLevel &level, const float *frames,
+                      int numFrames);
+
+  /** FFT processing methods */
+  void windowLatestHistory(const AnalysisLevel &level,
+                           int numActiveTaps); // Packs windowed L/R per tap
+  void separateSpectra(int tap); // L/R/M/S magnitudes of a packed transform
+  void analyseLevel(AnalysisLevel &level); // FFT + band mapping of one level
+  void drawNextFrameOfSpectrum();          // Triggers visualization update
+
+  /** Interval between worker wakeups (one display frame by default) */
+  std::atomic<int> wakeupIntervalMs{16};
+
+  /** Samples between analysis frames */
+  std::atomic<int> hopSize{fftSize / 4};
+
+  /** Audio thread -> worker thread FIFO of interleaved frames */
+  juce::AbstractFifo abstractFifo{fifoCapacity};
+  std::vector<float> fifoBuffer;
+
+  /** Set while an editor is open and the worker is consuming samples */
+  std::atomic<bool> active{false};
+
+  /** Sample rate of the analysed signal (written by prepare()) */
+  std::atomic<double> currentSampleRate{44100.0};
+
+  /** One display frame of normalised (0-1) scope levels for every tap and
+   * view */
+  struct SpectrumFrame {
+    float scope[numTaps][numViews][scopeSize];
+    float correlation = 0.0f;
+  };
+
+  /** Worker thread -> message thread frame exchange */
+  TripleBuffer<SpectrumFrame> spectrumFrames;
+
+  /** FFT analysis objects for spectrum visualization */
+  juce::dsp::FFT forwardFFT;  // FFT processor
+  float windowTable[fftSize]; // Precomputed Hann window
+
+  /** Band aggregation and resolution mode */
+  std::atomic<SpectrumBinMap::Aggregation> aggregation{
+      SpectrumBinMap::Aggregation::peak};
+  std::atomic<Resolution> resolution{Resolution::single};
+  std::atomic<bool> inputTapEnabled{false};
+
+  /** STFT state (worker thread only) */
+  AnalysisLevel levels[numLevels];
+  juce::dsp::Complex<float> fftInput[numTaps][fftSize];  // Windowed L + i * R
+  juce::dsp::Complex<float> fftOutput[numTaps][fftSize]; // Packed spectra
+  float magnitudes[numTaps][numViews][fftSize / 2]; // Separated magnitudes
+  int bandSourceLevel[scopeSize]; // Level used for each band in multi mode
+  double preparedSampleRate = 0.0;
+  Resolution appliedResolution = Resolution::single; // Mode of this wakeup
+
+  /** Running phase correlation (worker thread only) */
+  double sumLeftRight = 0.0, sumLeftSquared = 0.0, sumRightSquared = 0.0;
+  double correlationDecay = 0.0; // Per-frame leak for a ~300ms window
+
+  /** Decimated frames on their way to levels 1 and 2 */
+  std::vector<float> decimatedScratch[numLevels - 1];
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzerWorker)
+};
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    SpectrumBinMap.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+*/
+
+#include "SpectrumBinMap.h"
+
+//==============================================================================
+float SpectrumBinMap::getBandCentreFrequency(int band, int numBands) {
+  // Same log axis as the display: 20 * 1000^proportion => 20Hz to 20kHz
+  const float proportion = static_cast<float>(band) / static_cast<float>(numBands);
+  return minFrequency * std::pow(maxFrequency / minFrequency, proportion);
+}
+
+void SpectrumBinMap::build(double sampleRate, int fftSize, int numBands) {
+  mappedFftSize = fftSize;
+  normalisationDb = juce::Decibels::gainToDecibels(static_cast<float>(fftSize));
+
+  const int numBins = fftSize / 2;
+  const double binWidth = sampleRate / static_cast<double>(fftSize);
+
+  bands.assign(static_cast<size_t>(numBands), {});
+  binEnergy.assign(static_cast<size_t>(numBins), 0.0f);
+  cumulativeEnergy.assign(static_cast<size_t>(numBins) + 1, 0.0);
+
+  for (int b = 0; b < numBands; ++b) {
+    auto &band = bands[(size_t)b];
+
+    // Band edges sit half way (in log frequency) between neighbouring centres
+    const double lowEdge =
+        getBandCentreFrequency(b, numBands) *
+        std::pow(maxFrequency / minFrequency, -0.5 / numBands);
+    const double highEdge =
+        lowEdge * std::pow(maxFrequency / minFrequency, 1.0 / numBands);
+
+    // Bins whose centre frequency lies inside [lowEdge, highEdge)
+    const int first = juce::jlimit(0, numBins, (int)std::ceil(lowEdge / binWidth));
+    const int last = juce::jlimit(0, numBins, (int)std::ceil(highEdge / binWidth));
+
+    if (last > first) {
+      band.firstBin = first;
+      band.numBins = last - first;
+    } else {
+      // Band is narrower than one bin: interpolate at the band centre
+      const double position =
+          juce::jlimit(0.0, (double)(numBins - 1),
+                       getBandCentreFrequency(b, numBands) / binWidth);
+      band.firstBin = juce::jmin((int)position, numBins - 2);
+      band.numBins = 0;
+      band.fraction = static_cast<float>(position - band.firstBin);
+    }
+  }
+}
+
+//==============================================================================
+void SpectrumBinMap::process(const float *magnitudes, float *bandLevels,
+                             Aggregation aggregation) {
+  const int numBins = mappedFftSize / 2;
+
+  if (aggregation == Aggregation::powerMean) {
+    // Squares in one vectorised pass, then a running sum so each band's
+    // energy is a single subtraction regardless of its width
+    juce::FloatVectorOperations::multiply(binEnergy.data(), magnitudes,
+                                          magnitudes, numBins);
+    for (int k = 0; k < numBins; ++k)
+      cumulativeEnergy[(size_t)k + 1] =
+          cumulativeEnergy[(size_t)k] + binEnergy[(size_t)k];
+  }
+
+  for (size_t b = 0; b < bands.size(); ++b) {
+    const auto &band = bands[b];
+    float magnitude;
+
+    if (band.numBins == 0) {
+      const float left = magnitudes[band.firstBin];
+      const float right = magnitudes[band.firstBin + 1];
+      magnitude = left + band.fraction * (right - left);
+    } else if (aggregation == Aggregation::peak) {
+      magnitude = juce::FloatVectorOperations::findMaximum(
+          magnitudes + band.firstBin, band.numBins);
+    } else {
+      const double energy =
+          cumulativeEnergy[(size_t)(band.firstBin + band.numBins)] -
+          cumulativeEnergy[(size_t)band.firstBin];
+      magnitude = static_cast<float>(std::sqrt(energy / band.numBins));
+    }
+
+    bandLevels[b] = toDisplayLevel(magnitude);
+  }
+}
+
+float SpectrumBinMap::toDisplayLevel(float magnitude) const {
+  // Convert to decibels with normalization and limiting
+  const float level =
+      juce::jmax(minDb, juce::Decibels::gainToDecibels(magnitude) -
+                            normalisationDb);
+  return juce::jmap(level, minDb, maxDb, 0.0f, 1.0f);
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    SpectrumBinMap.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Precomputed mapping from FFT bins to the analyzer's logarithmic display
+  bands (20Hz - 20kHz).
+
+  Every display band owns the range of FFT bins that falls between its lower
+  and upper band edge, so high-frequency bands aggregate all of their bins
+  instead of sampling (and aliasing) a single one. Bands narrower than one bin
+  interpolate between the two nearest bins instead of repeating a value. The
+  table is only rebuilt when the sample rate, FFT size or band count changes,
+  which removes the per-frame std::pow calls from the analysis loop.
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * SpectrumBinMap
+ *
+ * Converts a magnitude spectrum into normalised (0-1) display band levels.
+ */
+class SpectrumBinMap {
+public:
+  /** How the bins inside one display band are combined */
+  enum class Aggregation {
+    peak,     // Loudest bin in the band (best for spotting resonances)
+    powerMean // RMS of the band's bins (energy-accurate, smoother)
+  };
+
+  /** Display range in Hz and decibels */
+  static constexpr float minFrequency = 20.0f;
+  static constexpr float maxFrequency = 20000.0f;
+  static constexpr float minDb = -100.0f;
+  static constexpr float maxDb = 0.0f;
+
+  /**
+   * Recomputes the band table. Allocates, so call it from a non-realtime
+   * thread (the analyzer worker does this whenever the sample rate changes).
+   */
+  void build(double sampleRate, int fftSize, int numBands);
+
+  /**
+   * Maps one frame of bin magnitudes (fftSize / 2 values, as produced by
+   * performFrequencyOnlyForwardTransform) to numBands display levels.
+   * Uses only preallocated storage.
+   */
+  void process(const float *magnitudes, float *bandLevels,
+               Aggregation aggregation);
+
+  /** Frequency at the centre of a display band */
+  static float getBandCentreFrequency(int band, int numBands);
+
+  /** Number of FFT bins aggregated by a band (0 = interpolated band) */
+  int getNumBinsInBand(int band) const { return bands[(size_t)band].numBins; }
+
+  /** First FFT bin of a band */
+  int getFirstBinOfBand(int band) const {
+    return bands[(size_t)band].firstBin;
+  }
+
+private:
+  struct Band {
+    int firstBin = 0;     // First bin of the range (or left interpolation bin)
+    int numBins = 0;      // Bins aggregated; 0 means interpolate instead
+    float fraction = 0.0f; // Interpolation weight towards firstBin + 1
+  };
+
+  std::vector<Band> bands;
+  std::vector<float> binEnergy;         // Squared magnitudes (power-mean)
+  std::vector<double> cumulativeEnergy; // Running sum of binEnergy
+  int mappedFftSize = 0;
+
+  /** Converts a linear FFT magnitude to a 0-1 display level */
+  float toDisplayLevel(float magnitude) const;
+
+  float normalisationDb = 0.0f; // Gain of a full-scale sine after the FFT
+};
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    TerminalRenderer.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+*/
+
+#include "TerminalRenderer.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+// Cursor move "ESC [ row ; column H" with up to 10 digit numbers, then the
+// character itself
+constexpr std::size_t maxBytesPerCell = 2 + 10 + 1 + 10 + 1 + 1;
+
+// "ESC [ H ESC [ 2 J": cursor home, clear screen
+constexpr char clearScreenSequence[] = "\x1b[H\x1b[2J";
+
+bool writeAll(int fileDescriptor, const char *data, std::size_t size) {
+  while (size > 0) {
+#ifdef _WIN32
+    const auto written = ::_write(fileDescriptor, data, (unsigned int)size);
+#else
+    const auto written = ::write(fileDescriptor, data, size);
+#endif
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+
+    data += written;
+    size -= (std::size_t)written;
+  }
+
+  return true;
+}
+} // namespace
+
+//==============================================================================
+TerminalRenderer::TerminalRenderer(int widthToUse, int heightToUse) {
+  resize(widthToUse, heightToUse);
+}
+
+void TerminalRenderer::resize(int newWidth, int newHeight) {
+  width = std::max(newWidth, 0);
+  height = std::max(newHeight, 0);
+
+  const auto numCells = (std::size_t)width * (std::size_t)height;
+  front.assign(numCells, ' ');
+  back.assign(numCells, ' ');
+  output.clear();
+  output.reserve(numCells * maxBytesPerCell + sizeof(clearScreenSequence));
+
+  invalidate();
+}
+
+void TerminalRenderer::clear(char fill) noexcept {
+  std::fill(back.begin(), back.end(), fill);
+}
+
+void TerminalRenderer::invalidate() noexcept {
+  // After clearing the screen, the terminal shows blanks
+  std::fill(front.begin(), front.end(), ' ');
+  clearScreen = true;
+  cursorX = cursorY = -1;
+}
+
+const std::string &TerminalRenderer::update() noexcept {
+  output.clear();
+
+  if (clearScreen) {
+    output.append(clearScreenSequence);
+    cursorX = cursorY = 0;
+    clearScreen = false;
+  }
+
+  for (int y = 0; y < height; ++y) {
+    const char *backRow = back.data() + (std::size_t)y * width;
+    char *frontRow = front.data() + (std::size_t)y * width;
+
+    for (int x = 0; x < width; ++x) {
+      if (backRow[x] == frontRow[x])
+        continue;
+
+      // Short runs of unchanged cells are cheaper to print again than to
+      // jump over
+      const int gap = x - cursorX;
+      if (cursorY == y && gap >= 0 && gap <= maxRewrittenGap)
+        output.append(backRow + cursorX, (std::size_t)gap);
+      else
+        moveCursor(x, y);
+
+      output.push_back(backRow[x]);
+      frontRow[x] = backRow[x];
+
+      // Printing into the last column leaves the cursor in a
+      // terminal-dependent wrap state
+      cursorX = x + 1 < width ? x + 1 : -1;
+      cursorY = y;
+    }
+  }
+
+  return output;
+}
+
+bool TerminalRenderer::present(int fileDescriptor) noexcept {
+  const auto &bytes = update();
+  return bytes.empty() || writeAll(fileDescriptor, bytes.data(), bytes.size());
+}
+
+void TerminalRenderer::moveCursor(int x, int y) noexcept {
+  output.append("\x1b[");
+  appendNumber(y + 1);
+  output.push_back(';');
+  appendNumber(x + 1);
+  output.push_back('H');
+}
+
+void TerminalRenderer::appendNumber(int value) noexcept {
+  char digits[10];
+  int numDigits = 0;
+  do {
+    digits[numDigits++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  while (numDigits > 0)
+    output.push_back(digits[--numDigits]);
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    TerminalRenderer.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Character-cell output for the headless spectrum analyzer.
+
+  Frames are drawn into a back buffer of width x height cells. present()
+  compares it with the front buffer (what the terminal currently shows),
+  encodes only the cells that changed - moving the cursor with ANSI escape
+  sequences where the next change is not right behind the previous one -
+  into an output buffer sized for the worst case when the renderer is
+  resized, and hands the result to the terminal in one write(). A static
+  frame costs nothing, and a moving spectrum costs a few bytes per changed
+  cell instead of a full-screen reprint, which matters over SSH.
+
+  No JUCE dependencies.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//==============================================================================
+/**
+ * TerminalRenderer
+ *
+ * Double-buffered grid of single-byte characters. Coordinates are 0-based
+ * with (0, 0) in the top left corner. Nothing allocates except resize().
+ */
+class TerminalRenderer {
+public:
+  /** Allocates both buffers and the output buffer */
+  TerminalRenderer(int width, int height);
+
+  /** Reallocates for a new terminal size; the next frame is a full redraw */
+  void resize(int width, int height);
+
+  int getWidth() const noexcept { return width; }
+  int getHeight() const noexcept { return height; }
+
+  /** Fills the back buffer */
+  void clear(char fill = ' ') noexcept;
+
+  /** Writes one back buffer cell; cells outside the grid are ignored */
+  void setCell(int x, int y, char c) noexcept {
+    if (x >= 0 && x < width && y >= 0 && y < height)
+      back[(std::size_t)(y * width + x)] = c;
+  }
+
+  /** Reads one back buffer cell (' ' outside the grid) */
+  char getCell(int x, int y) const noexcept {
+    return x >= 0 && x < width && y >= 0 && y < height
+               ? back[(std::size_t)(y * width + x)]
+               : ' ';
+  }
+
+  /** Forgets what the terminal shows: the next update clears the screen and
+   * redraws every non-blank cell (e.g. after the terminal was resized or
+   * written to by someone else) */
+  void invalidate() noexcept;
+
+  /**
+   * Encodes the changes from the front to the back buffer and makes the
+   * back buffer the new front. The back buffer keeps its contents.
+   * @return the bytes to send to the terminal, valid until the next call
+   */
+  const std::string &update() noexcept;
+
+  /**
+   * update() followed by a single write() of the result to fileDescriptor
+   * (a loop only if the descriptor accepts a partial write).
+   * @return false if writing failed
+   */
+  bool present(int fileDescriptor = 1) noexcept;
+
+private:
+  void moveCursor(int x, int y) noexcept;
+  void appendNumber(int value) noexcept;
+
+  /** Largest gap of unchanged cells that is rewritten rather than skipped
+   * with a cursor move (which costs at least six bytes) */
+  static constexpr int maxRewrittenGap = 4;
+
+  int width = 0, height = 0;
+  std::vector<char> front, back; // Row-major, width * height cells
+  std::string output;            // Reserved for a full redraw
+  int cursorX = -1, cursorY = -1; // Terminal cursor, -1 when unknown
+  bool clearScreen = true;
+};
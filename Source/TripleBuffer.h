@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  Lock-free triple buffer for handing complete snapshots from one thread to
+  another (e.g. spectrum frames from the analyzer thread to the editor).
+
+  Three slots rotate between the producer, the consumer and a shared "latest"
+  slot. Publishing and fetching are a single atomic exchange each, so neither
+  side ever blocks or waits for the other. The consumer always sees the most
+  recent complete snapshot; intermediate snapshots the consumer was too slow
+  to pick up are simply overwritten. Every published snapshot carries a
+  sequence number so the consumer can tell new data from a repeat and detect
+  skipped frames.
+
+  No JUCE dependencies - this header is shared with the standalone analyzer.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+template <typename SnapshotType> class TripleBuffer {
+public:
+  TripleBuffer() = default;
+
+  //==============================================================================
+  // Producer side (one thread only)
+
+  /** Returns the slot the producer may fill. It stays private to the producer
+   * until publish() is called. */
+  SnapshotType &getWriteBuffer() noexcept { return slots[writeIndex]; }
+
+  /** Makes the write slot the latest snapshot and hands the producer a fresh
+   * slot to fill. Never blocks. */
+  void publish() noexcept {
+    sequences[writeIndex] = ++producerSequence;
+    const auto previous =
+        shared.exchange(writeIndex | newDataFlag, std::memory_order_acq_rel);
+    writeIndex = previous & indexMask;
+  }
+
+  //==============================================================================
+  // Consumer side (one thread only)
+
+  /** Takes ownership of the latest published snapshot, if there is one the
+   * consumer has not seen yet. Never blocks.
+   * @return true when getReadBuffer() now holds a newer snapshot */
+  bool fetch() noexcept {
+    if ((shared.load(std::memory_order_relaxed) & newDataFlag) == 0)
+      return false;
+
+    const auto previous =
+        shared.exchange(readIndex, std::memory_order_acq_rel);
+    readIndex = previous & indexMask;
+    return true;
+  }
+
+  /** The snapshot most recently obtained by fetch() */
+  const SnapshotType &getReadBuffer() const noexcept {
+    return slots[readIndex];
+  }
+
+  /** Sequence number of getReadBuffer() (0 = nothing published yet). Gaps
+   * between consecutive values mean the producer outran the consumer. */
+  std::uint64_t getReadSequence() const noexcept {
+    return sequences[readIndex];
+  }
+
+private:
+  static constexpr std::uint32_t indexMask = 3;
+  static constexpr std::uint32_t newDataFlag = 4;
+
+  std::array<SnapshotType, 3> slots{};
+  std::array<std::uint64_t, 3> sequences{};
+
+  // Producer-owned state
+  std::uint32_t writeIndex = 0;
+  std::uint64_t producerSequence = 0;
+
+  // Slot index shared between both sides, plus the "unread" flag
+  alignas(64) std::atomic<std::uint32_t> shared{1};
+
+  // Consumer-owned state
+  alignas(64) std::uint32_t readIndex = 2;
+};
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    WavePhysics.cpp
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+*/
+
+#include "WavePhysics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+//==============================================================================
+WavePhysics::WavePhysics(int numPointsToUse)
+    : numPoints(std::max(numPointsToUse, 0)),
+      points(static_cast<std::size_t>(numPoints), 0.0f),
+      velocities(static_cast<std::size_t>(numPoints), 0.0f) {}
+
+int WavePhysics::advance(const float *targets, double elapsedSeconds) noexcept {
+  if (elapsedSeconds > 0.0)
+    accumulatedSeconds += elapsedSeconds;
+
+  int numSteps = 0;
+  while (accumulatedSeconds >= stepSeconds && numSteps < maxStepsPerAdvance) {
+    step(targets);
+    accumulatedSeconds -= stepSeconds;
+    ++numSteps;
+  }
+
+  // After a stall, drop what could not be simulated rather than carrying a
+  // backlog into the following frames
+  if (numSteps == maxStepsPerAdvance)
+    accumulatedSeconds = std::fmod(accumulatedSeconds, stepSeconds);
+
+  return numSteps;
+}
+
+void WavePhysics::step(const float *targets) noexcept {
+  kernels->waveSpringStep(points.data(), velocities.data(), targets,
+                          numPoints, settings.tension, settings.damping,
+                          settings.speed, settings.spreadFactor);
+}
+
+void WavePhysics::reset() noexcept {
+  std::fill(points.begin(), points.end(), 0.0f);
+  std::fill(velocities.begin(), velocities.end(), 0.0f);
+  accumulatedSeconds = 0.0;
+}
+
+bool WavePhysics::isSettled(const float *targets,
+                            float threshold) const noexcept {
+  for (int i = 0; i < numPoints; ++i)
+    if (std::abs(targets[i] - points[i]) > threshold ||
+        std::abs(velocities[i]) > threshold)
+      return false;
+
+  return true;
+}
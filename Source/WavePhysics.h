@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    WavePhysics.h
+    Created: 2023
+    Author:  Audio Developer
+
+  ==============================================================================
+
+  The spring/spread simulation behind the analyzer's wave animation, shared by
+  the plugin editor and the standalone analyzer.
+
+  Points, velocities and targets live in arrays allocated once, and each step
+  is one pass of the SIMD wave kernel (see DspKernels.h). The simulation runs
+  at a fixed rate: callers report how much time has passed and the solver
+  takes as many whole steps as fit, carrying the remainder to the next call.
+  The wave therefore moves at the same speed whether it is repainted at 144,
+  60 or 10 frames per second, and a stalled caller catches up by at most
+  maxStepsPerAdvance steps instead of exploding.
+
+  No JUCE dependencies.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "DspKernels.h"
+
+//==============================================================================
+/**
+ * WavePhysics
+ *
+ * A row of points, each pulled towards a target by a damped spring and
+ * towards its neighbours by a spread force. Values are in display units
+ * (0-1).
+ */
+class WavePhysics {
+public:
+  /** Spring constants, applied once per fixed step */
+  struct Settings {
+    float tension = 0.025f;     // How strongly points pull toward targets
+    float damping = 0.97f;      // Velocity kept per step
+    float spreadFactor = 0.2f;  // How much adjacent points influence each other
+    float speed = 0.05f;        // Velocity -> position scale per step
+  };
+
+  /** Length of one simulation step (the rate the constants were tuned at) */
+  static constexpr double stepSeconds = 1.0 / 60.0;
+
+  /** Most steps one advance() takes; older time is dropped */
+  static constexpr int maxStepsPerAdvance = 8;
+
+  /** Allocates storage for numPoints points, all at rest at zero */
+  explicit WavePhysics(int numPoints);
+
+  void setSettings(const Settings &newSettings) noexcept {
+    settings = newSettings;
+  }
+  const Settings &getSettings() const noexcept { return settings; }
+
+  /**
+   * Moves the simulation forward by elapsedSeconds of wall-clock time,
+   * chasing targets (getNumPoints() values).
+   * @return number of fixed steps taken
+   */
+  int advance(const float *targets, double elapsedSeconds) noexcept;
+
+  /** Takes exactly one fixed step towards targets */
+  void step(const float *targets) noexcept;
+
+  /** Puts every point at rest at zero and drops any accumulated time */
+  void reset() noexcept;
+
+  /** True if every point is within threshold of its target and nearly still */
+  bool isSettled(const float *targets, float threshold) const noexcept;
+
+  int getNumPoints() const noexcept { return numPoints; }
+  const float *getPoints() const noexcept { return points.data(); }
+  const float *getVelocities() const noexcept { return velocities.data(); }
+
+private:
+  int numPoints;
+  std::vector<float> points, velocities;
+  Settings settings;
+  double accumulatedSeconds = 0.0; // Time not yet covered by a whole step
+
+  const DspKernels::KernelTable *kernels = &DspKernels::getBestKernels();
+};
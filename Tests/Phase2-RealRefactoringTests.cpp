@@ -32,11 +32,13 @@
 #include <juce_events/juce_events.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Create a simple JuceHeader.h proxy for our test (before including
@@ -48,6 +50,7 @@
 
 // Include our processor after setting up JUCE environment
 #include "../Source/PluginProcessor.h"
+#include "../Source/SpectrumBinMap.h"
 
 //==============================================================================
 // Phase 2 Test Framework - Focused on Real Code
@@ -85,6 +88,46 @@ static void beginTest(const std::string &testName) {
   std::cout << "\n🔍 Testing: " << testName << std::endl;
 }
 
+/** Processes one block of a sine tone, the same on both channels and
+ * continuing from the previous block (an amplitude of 0 gives silence).
+ * Returns whether every output sample stayed finite. */
+static bool processToneBlock(CustomReverbAudioProcessor &processor,
+                             juce::AudioBuffer<float> &buffer, int block,
+                             float amplitude, float radiansPerSample) {
+  const int numSamples = buffer.getNumSamples();
+  for (int sample = 0; sample < numSamples; ++sample) {
+    const float tone =
+        amplitude *
+        std::sin(radiansPerSample * (float)(block * numSamples + sample));
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+      buffer.setSample(channel, sample, tone);
+  }
+  juce::MidiBuffer midi;
+  processor.processBlock(buffer, midi);
+
+  bool allFinite = true;
+  for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    for (int sample = 0; sample < numSamples; ++sample)
+      allFinite &= std::isfinite(buffer.getSample(channel, sample));
+  return allFinite;
+}
+
+/** Processes a unit impulse and returns the first output sample. After
+ * silence only the reverb's dry path and the undelayed high band reach that
+ * sample, so it follows the parameters without any reverb tail. */
+static float processImpulseBlock(CustomReverbAudioProcessor &processor,
+                                 juce::AudioBuffer<float> &buffer) {
+  buffer.clear();
+  for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    buffer.setSample(channel, 0, 1.0f);
+  juce::MidiBuffer midi;
+  processor.processBlock(buffer, midi);
+  return buffer.getSample(0, 0);
+}
+
+/** Radians per sample of an A440 tone at 44.1 kHz */
+static constexpr float a440At44k = 2.0f * 3.14159f * 440.0f / 44100.0f;
+
 //==============================================================================
 // Phase 2 Core Tests - Real ReverbWave Code
 //==============================================================================
@@ -435,6 +478,309 @@ static void testParameterToAudioIntegration() {
   }
 }
 
+static void testBlockRateParameterUpdates() {
+  beginTest("Parameter Changes Apply At The Next Block");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 256);
+    auto &apvts = processor->getAPVTS();
+
+    // Silence both reverb paths and push the high band 500ms into the delay
+    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("highFreqMix")->setValueNotifyingHost(1.0f);
+    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(1.0f);
+
+    juce::AudioBuffer<float> buffer(2, 256);
+    auto processTone = [&](int block) {
+      processToneBlock(*processor, buffer, block, 0.5f, a440At44k);
+      return buffer.getMagnitude(0, 128, 128);
+    };
+
+    // Let the reverb's internal gain smoothing settle
+    float silentLevel = 0.0f;
+    for (int block = 0; block < 8; ++block)
+      silentLevel = processTone(block);
+    expect(silentLevel < 1.0e-4f,
+           "Muted reverb and delayed high band should leave silence");
+
+    // One change, taken over by adoptParameterSnapshot() when the next block
+    // starts
+    apvts.getParameter("dryLevel")->setValueNotifyingHost(1.0f);
+    float level = 0.0f;
+    for (int block = 8; block < 12; ++block)
+      level = processTone(block);
+    expect(level > 0.01f, "Raising the dry level should reach the output");
+  } catch (const std::exception &e) {
+    expect(false, std::string("Block-rate parameter test threw exception: ") +
+                      e.what());
+  }
+}
+
+static void testParameterSmoothing() {
+  beginTest("Automation Ramps Without Discontinuities");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 2048);
+    auto &apvts = processor->getAPVTS();
+
+    // Only the high band and its delay reach the output
+    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("highFreqMix")->setValueNotifyingHost(0.0f);
+
+    // Largest sample-to-sample step of a block, including the step from the
+    // previous block's last sample
+    juce::AudioBuffer<float> buffer(2, 2048);
+    float previousSample = 0.0f;
+    auto processTone = [&](int block) {
+      processToneBlock(*processor, buffer, block, 0.5f, a440At44k);
+
+      float largestStep = 0.0f;
+      for (int sample = 0; sample < 2048; ++sample) {
+        const float current = buffer.getSample(0, sample);
+        largestStep = std::max(largestStep, std::abs(current - previousSample));
+        previousSample = current;
+      }
+      return largestStep;
+    };
+
+    float settledStep = 0.0f;
+    for (int block = 0; block < 8; ++block)
+      settledStep = processTone(block);
+
+    // Jump the mix, crossover and delay in one go; the mix and crossover
+    // should ramp and the delay crossfade, not step
+    apvts.getParameter("highFreqMix")->setValueNotifyingHost(1.0f);
+    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(0.9f);
+    apvts.getParameter("highFreqDelay")->setValueNotifyingHost(0.9f);
+    float changedStep = 0.0f;
+    for (int block = 8; block < 10; ++block)
+      changedStep = std::max(changedStep, processTone(block));
+
+    expect(changedStep < settledStep * 2.0f + 0.01f,
+           "A large parameter change should not click at a large block size");
+  } catch (const std::exception &e) {
+    expect(false, std::string("Parameter smoothing test threw exception: ") +
+                      e.what());
+  }
+}
+
+static void testConcurrentParameterSnapshots() {
+  beginTest("Parameter Snapshots Under Concurrent Automation");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 256);
+    auto &apvts = processor->getAPVTS();
+
+    // Another thread automates every parameter while blocks are processed
+    std::atomic<bool> running{true};
+    std::thread automation([&] {
+      const char *ids[] = {"roomSize",         "damping",       "wetLevel",
+                           "dryLevel",         "width",         "crossoverFreq",
+                           "highFreqDelay",    "highFreqMix",
+                           "harmDetuneAmount"};
+      for (int step = 0; running.load(); ++step)
+        for (auto *id : ids)
+          apvts.getParameter(id)->setValueNotifyingHost(
+              (float)((step * 7) % 11) / 10.0f);
+    });
+
+    juce::AudioBuffer<float> buffer(2, 256);
+    bool allFinite = true;
+    for (int block = 0; block < 200; ++block)
+      allFinite &= processToneBlock(*processor, buffer, block, 0.5f, 0.05f);
+
+    running = false;
+    automation.join();
+    expect(allFinite, "Output should stay finite while parameters change "
+                      "on another thread");
+  } catch (const std::exception &e) {
+    expect(false, std::string("Concurrent parameter test threw exception: ") +
+                      e.what());
+  }
+}
+
+static void testPresetBank() {
+  beginTest("Preset Bank Programs And Morphing");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 512);
+    auto &apvts = processor->getAPVTS();
+
+    expect(processor->getNumPrograms() == 8 &&
+               processor->getProgramName(2) == "Large Hall" &&
+               processor->getProgramName(8).isEmpty(),
+           "The preset bank should be exposed as host programs");
+
+    // Every parameter follows a program change, harmonic detune included
+    processor->setCurrentProgram(7);
+    expect(processor->getCurrentProgram() == 7,
+           "Current program should follow the last program change");
+    expectWithinError(apvts.getParameter("harmDetuneAmount")->getValue(), 0.7f,
+                      0.001f, "Harmonic detune should be set by its preset");
+    expectWithinError(apvts.getParameter("crossoverFreq")->getValue(), 0.6f,
+                      0.001f, "Crossover should be set by its preset");
+
+    // Morph to a very different space over half a second
+    juce::AudioBuffer<float> buffer(2, 512);
+    for (int block = 0; block < 4; ++block)
+      processToneBlock(*processor, buffer, block, 0.5f, 0.05f);
+
+    processor->setPresetMorphTime(0.5f);
+    processor->setCurrentProgram(3);
+    expectWithinError(apvts.getParameter("roomSize")->getValue(), 0.95f,
+                      0.001f, "Parameters should jump to the preset at once");
+    bool allFinite = true;
+    for (int block = 4; block < 64; ++block)
+      allFinite &= processToneBlock(*processor, buffer, block, 0.5f, 0.05f);
+    expect(allFinite, "Output should stay finite while morphing");
+
+    // Each probe starts from Cathedral and takes an impulse numBlocks into
+    // the morph; changeMixAt (if any) touches another parameter that many
+    // blocks into the morph
+    auto impulseGain = [](int preset, float morphSeconds, int numBlocks,
+                          int changeMixAt) {
+      auto probe = std::make_unique<CustomReverbAudioProcessor>();
+      probe->prepareToPlay(44100.0, 256);
+      juce::AudioBuffer<float> probeBuffer(2, 256);
+
+      probe->setCurrentProgram(3);
+      for (int block = 0; block < 20; ++block)
+        processToneBlock(*probe, probeBuffer, block, 0.0f, 0.0f);
+      probe->setPresetMorphTime(morphSeconds);
+      probe->setCurrentProgram(preset);
+      for (int block = 0; block < numBlocks; ++block) {
+        if (block == changeMixAt)
+          probe->getAPVTS().getParameter("highFreqMix")->setValueNotifyingHost(
+              0.6f);
+        processToneBlock(*probe, probeBuffer, block, 0.0f, 0.0f);
+      }
+      return processImpulseBlock(*probe, probeBuffer);
+    };
+
+    // Cathedral to Bright Chamber; 0.5 s is about 86 blocks of 256 samples
+    const float startGain = impulseGain(3, 0.0f, 20, -1);
+    const float targetGain = impulseGain(5, 0.0f, 20, -1);
+    const float partwayGain = impulseGain(5, 0.5f, 43, -1);
+    expect(std::abs(targetGain - startGain) > 0.1f,
+           "The morph test presets should sound different");
+    expect(partwayGain > std::min(startGain, targetGain) + 0.01f &&
+               partwayGain < std::max(startGain, targetGain) - 0.01f,
+           "Halfway through a morph the sound should be in between presets");
+    expectWithinError(impulseGain(5, 0.5f, 100, -1), targetGain, 1.0e-4f,
+                      "A finished morph should arrive at the preset");
+    expectWithinError(impulseGain(5, 0.5f, 30, 10),
+                      impulseGain(5, 0.0f, 30, 10), 1.0e-4f,
+                      "Another parameter change should end a morph");
+  } catch (const std::exception &e) {
+    expect(false, std::string("Preset bank test threw exception: ") + e.what());
+  }
+}
+
+static void testMorphPad() {
+  beginTest("XY Morph Pad Between Presets");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 256);
+    auto &apvts = processor->getAPVTS();
+    const float roomSizeBefore = apvts.getParameter("roomSize")->getValue();
+
+    // Two presets span the pad from left to right: Cathedral and Bright
+    // Chamber
+    const int presets[] = {3, 5};
+    processor->setMorphPresets(presets, 2);
+    expect(processor->getMorphPreset(0) == 3 &&
+               processor->getMorphPreset(1) == 5 &&
+               processor->getMorphPreset(2) == 3 &&
+               processor->getMorphPreset(3) == 5,
+           "Two presets should fill the left and right corners");
+
+    // Sweep the pad at roughly 100 Hz worth of positions per block
+    processor->setMorphPadEnabled(true);
+    juce::AudioBuffer<float> buffer(2, 256);
+    bool allFinite = true;
+    for (int block = 0; block < 200; ++block) {
+      processor->setMorphPosition(0.5f + 0.5f * std::sin(0.05f * block), 0.3f);
+      allFinite &= processToneBlock(*processor, buffer, block, 0.3f, 0.07f);
+    }
+    expect(allFinite, "Output should stay finite while the pad moves");
+    expectWithinError(apvts.getParameter("roomSize")->getValue(),
+                      roomSizeBefore, 1.0e-6f,
+                      "The pad should not go through the parameters");
+
+    // Each side of the pad should sound like its preset
+    auto impulseGainAt = [&presets](float x) {
+      auto probe = std::make_unique<CustomReverbAudioProcessor>();
+      probe->prepareToPlay(44100.0, 256);
+      probe->setMorphPresets(presets, 2);
+      probe->setMorphPosition(x, 0.3f);
+      probe->setMorphPadEnabled(true);
+      juce::AudioBuffer<float> probeBuffer(2, 256);
+      for (int block = 0; block < 20; ++block)
+        processToneBlock(*probe, probeBuffer, block, 0.0f, 0.0f);
+      return processImpulseBlock(*probe, probeBuffer);
+    };
+    expect(std::abs(impulseGainAt(0.0f) - impulseGainAt(1.0f)) > 0.1f,
+           "Opposite sides of the pad should sound different");
+
+    // Positions are clamped to the pad
+    processor->setMorphPosition(2.0f, -1.0f);
+    expect(processor->getMorphPosition() == juce::Point<float>(1.0f, 0.0f),
+           "Morph position should be clamped to 0-1");
+
+    processor->setMorphPadEnabled(false);
+  } catch (const std::exception &e) {
+    expect(false, std::string("Morph pad test threw exception: ") + e.what());
+  }
+}
+
+static void testMorphPadState() {
+  beginTest("Morph Pad Saved With The Session");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 256);
+    const int presets[] = {1, 2, 4, 6};
+    processor->setMorphPresets(presets, 4);
+    processor->setMorphPosition(0.2f, 0.9f);
+    processor->setMorphPadEnabled(true);
+
+    juce::MemoryBlock state;
+    processor->getStateInformation(state);
+    auto restored = std::make_unique<CustomReverbAudioProcessor>();
+    restored->prepareToPlay(44100.0, 256);
+    restored->setStateInformation(state.getData(), (int)state.getSize());
+
+    expect(restored->isMorphPadEnabled() &&
+               restored->getMorphPosition() ==
+                   juce::Point<float>(0.2f, 0.9f),
+           "The pad position and switch should be restored");
+    bool cornersMatch = true;
+    for (int corner = 0; corner < 4; ++corner)
+      cornersMatch &= restored->getMorphPreset(corner) == presets[corner];
+    expect(cornersMatch, "The pad's corner presets should be restored");
+
+    // The restored instance should sound like the saved one
+    juce::AudioBuffer<float> buffer(2, 256);
+    for (int block = 0; block < 20; ++block) {
+      processToneBlock(*processor, buffer, block, 0.0f, 0.0f);
+      processToneBlock(*restored, buffer, block, 0.0f, 0.0f);
+    }
+    expectWithinError(processImpulseBlock(*restored, buffer),
+                      processImpulseBlock(*processor, buffer), 1.0e-6f,
+                      "A restored pad should sound the same");
+  } catch (const std::exception &e) {
+    expect(false,
+           std::string("Morph pad state test threw exception: ") + e.what());
+  }
+}
+
 static void testProcessorStateManagement() {
   beginTest("Processor State Save/Load");
 
@@ -485,6 +831,397 @@ static void testProcessorStateManagement() {
   }
 }
 
+static void testLegacyXmlStateLoading() {
+  beginTest("Binary State With XML Fallback");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    auto &apvts = processor->getAPVTS();
+    apvts.getParameter("width")->setValueNotifyingHost(0.2f);
+    apvts.getParameter("highFreqMix")->setValueNotifyingHost(0.9f);
+
+    // New sessions store the binary chunk: 8 byte header + 8 per parameter
+    juce::MemoryBlock binaryState;
+    processor->getStateInformation(binaryState);
+    expect(binaryState.getSize() == 8 + 8 * 10 &&
+               ParameterState::isBinaryState(binaryState.getData(),
+                                             binaryState.getSize()),
+           "Saved state should be a binary chunk");
+
+    // Older sessions stored the parameter tree as XML
+    juce::MemoryBlock xmlState;
+    std::unique_ptr<juce::XmlElement> xml(apvts.copyState().createXml());
+    juce::AudioProcessor::copyXmlToBinary(*xml, xmlState);
+
+    for (auto *state : {&binaryState, &xmlState}) {
+      auto restored = std::make_unique<CustomReverbAudioProcessor>();
+      restored->setStateInformation(state->getData(),
+                                    static_cast<int>(state->getSize()));
+      auto &restoredTree = restored->getAPVTS();
+      expectWithinError(restoredTree.getParameter("width")->getValue(), 0.2f,
+                        0.01f, "Width should be restored");
+      expectWithinError(restoredTree.getParameter("highFreqMix")->getValue(),
+                        0.9f, 0.01f, "HF mix should be restored");
+    }
+
+    // Garbage is ignored rather than resetting anything
+    const char garbage[] = "not a state chunk";
+    processor->setStateInformation(garbage, sizeof(garbage));
+    expectWithinError(apvts.getParameter("width")->getValue(), 0.2f, 0.01f,
+                      "Unreadable state should leave parameters untouched");
+  } catch (const std::exception &e) {
+    expect(false, std::string("State format test threw exception: ") +
+                      e.what());
+  }
+}
+
+static void testLazySpectrumAnalyzer() {
+  beginTest("Lazily Created Spectrum Analyzer");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(48000.0, 256);
+
+    std::vector<float> frame(CustomReverbAudioProcessor::scopeSize, 0.0f);
+    juce::AudioBuffer<float> buffer(2, 256);
+    juce::MidiBuffer midiBuffer;
+
+    // An instance whose editor never opened processes without an analyzer
+    buffer.clear();
+    processor->setSpectrumAnalyzerActive(false);
+    processor->processBlock(buffer, midiBuffer);
+    expect(!processor->pullSpectrumFrame(frame.data(), (int)frame.size()),
+           "No frames should exist before the analyzer is created");
+    expectWithinError(processor->getSpectrumCorrelation(), 0.0f, 1.0e-6f,
+                      "Correlation should read 0 before the analyzer exists");
+
+    // The first request creates it; later ones return the same object
+    auto &worker = processor->getSpectrumAnalyzerWorker();
+    expect(&worker == &processor->getSpectrumAnalyzerWorker(),
+           "The analyzer should be created only once");
+
+    // Destroying the processor with the analyzer running stops it first
+    processor->setSpectrumAnalyzerActive(true);
+    processor->processBlock(buffer, midiBuffer);
+    processor.reset();
+    expect(true, "Processor with a running analyzer should shut down cleanly");
+  } catch (const std::exception &e) {
+    expect(false,
+           std::string("Lazy analyzer test threw exception: ") + e.what());
+  }
+}
+
+static void testBackgroundSpectrumAnalysis() {
+  beginTest("Background Spectrum Analysis Hand-off");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 512);
+
+    std::vector<float> frame(CustomReverbAudioProcessor::scopeSize, 0.0f);
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midiBuffer;
+
+    // Without an editor the analyzer must stay idle
+    buffer.clear();
+    processor->processBlock(buffer, midiBuffer);
+    expect(!processor->pullSpectrumFrame(frame.data(), (int)frame.size()),
+           "No spectrum frames should be produced while no editor is open");
+
+    processor->setSpectrumAnalyzerActive(true);
+
+    // Feed a 1kHz tone; the worker thread turns it into frames
+    int phase = 0;
+    bool gotFrame = false;
+    for (int attempt = 0; attempt < 100 && !gotFrame; ++attempt) {
+      for (int sample = 0; sample < 512; ++sample, ++phase) {
+        float tone =
+            0.5f * std::sin(2.0f * 3.14159265f * 1000.0f * phase / 44100.0f);
+        buffer.setSample(0, sample, tone);
+        buffer.setSample(1, sample, tone);
+      }
+      processor->processBlock(buffer, midiBuffer);
+      juce::Thread::sleep(5);
+      gotFrame = processor->pullSpectrumFrame(frame.data(), (int)frame.size());
+    }
+
+    expect(gotFrame, "Editor should be able to pull a spectrum frame");
+
+    if (gotFrame) {
+      auto peak = std::max_element(frame.begin(), frame.end());
+      const int peakIndex = static_cast<int>(peak - frame.begin());
+
+      // 1kHz sits at log(1000/20)/log(1000) of the 20Hz-20kHz scope axis
+      const float expectedIndex = CustomReverbAudioProcessor::scopeSize *
+                                  std::log(1000.0f / 20.0f) /
+                                  std::log(1000.0f);
+      expectWithinError(static_cast<float>(peakIndex), expectedIndex, 8.0f,
+                        "Spectrum peak should sit at 1kHz on the scope axis");
+    }
+
+    processor->setSpectrumAnalyzerActive(false);
+    expect(true, "Analyzer thread should stop cleanly");
+  } catch (const std::exception &e) {
+    expect(false,
+           std::string("Spectrum analysis test threw exception: ") + e.what());
+  }
+}
+
+static void testMultiResolutionSpectrum() {
+  beginTest("Multi-Resolution Spectrum Analysis");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 512);
+    processor->getSpectrumAnalyzerWorker().setResolution(
+        SpectrumAnalyzerWorker::Resolution::multi);
+    processor->setSpectrumAnalyzerActive(true);
+
+    std::vector<float> frame(CustomReverbAudioProcessor::scopeSize, 0.0f);
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midiBuffer;
+
+    // 60Hz is below the first whole bin of the full-rate FFT; the level
+    // decimated by 16 needs 16 * fftSize input samples to fill its window
+    int phase = 0;
+    bool gotFrame = false;
+    for (int block = 0; block < 160; ++block) {
+      for (int sample = 0; sample < 512; ++sample, ++phase) {
+        float tone =
+            0.5f * std::sin(2.0f * 3.14159265f * 60.0f * phase / 44100.0f);
+        buffer.setSample(0, sample, tone);
+        buffer.setSample(1, sample, tone);
+      }
+      processor->processBlock(buffer, midiBuffer);
+      juce::Thread::sleep(2);
+
+      if (block >= 100)
+        gotFrame |=
+            processor->pullSpectrumFrame(frame.data(), (int)frame.size());
+    }
+
+    expect(gotFrame, "Multi-resolution analyzer should publish frames");
+
+    if (gotFrame) {
+      auto peak = std::max_element(frame.begin(), frame.end());
+      const int peakIndex = static_cast<int>(peak - frame.begin());
+
+      const float expectedIndex = CustomReverbAudioProcessor::scopeSize *
+                                  std::log(60.0f / 20.0f) / std::log(1000.0f);
+      expectWithinError(static_cast<float>(peakIndex), expectedIndex, 6.0f,
+                        "Low-frequency peak should sit at 60Hz");
+    }
+
+    // Back in single-resolution mode the decimated levels are idle, so once
+    // the input stops no further frames may be published
+    processor->getSpectrumAnalyzerWorker().setResolution(
+        SpectrumAnalyzerWorker::Resolution::single);
+    for (int block = 0; block < 8; ++block) {
+      processor->processBlock(buffer, midiBuffer);
+      juce::Thread::sleep(2);
+    }
+    juce::Thread::sleep(100);
+    processor->pullSpectrumFrame(frame.data(), (int)frame.size());
+    juce::Thread::sleep(100);
+    expect(!processor->pullSpectrumFrame(frame.data(), (int)frame.size()),
+           "No frames should be republished without new input after "
+           "switching to single resolution");
+
+    processor->setSpectrumAnalyzerActive(false);
+  } catch (const std::exception &e) {
+    expect(false, std::string("Multi-resolution test threw exception: ") +
+                      e.what());
+  }
+}
+
+static void testStereoSpectrumViews() {
+  beginTest("Stereo Spectrum Views and Correlation");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 512);
+
+    // Keep the signal as dry as possible so the analyzer sees the test
+    // pattern rather than the reverb's stereo spread
+    auto &apvts = processor->getAPVTS();
+    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("dryLevel")->setValueNotifyingHost(1.0f);
+    apvts.getParameter("highFreqMix")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("harmDetuneAmount")->setValueNotifyingHost(0.0f);
+
+    using View = SpectrumAnalyzerWorker::View;
+    const int scopeSize = CustomReverbAudioProcessor::scopeSize;
+    std::vector<float> mid(scopeSize), side(scopeSize), left(scopeSize),
+        right(scopeSize);
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midiBuffer;
+
+    // Runs a steady pattern and pulls the mid and side views from alternate
+    // frames; rightGain scales the left tone into the right channel
+    auto analyse = [&](float rightGain) {
+      processor->setSpectrumAnalyzerActive(true);
+      bool gotMid = false, gotSide = false;
+      int phase = 0;
+      for (int block = 0; block < 40; ++block) {
+        for (int sample = 0; sample < 512; ++sample, ++phase) {
+          float tone =
+              0.5f * std::sin(2.0f * 3.14159265f * 1000.0f * phase / 44100.0f);
+          buffer.setSample(0, sample, tone);
+          buffer.setSample(1, sample, rightGain * tone);
+        }
+        processor->processBlock(buffer, midiBuffer);
+        juce::Thread::sleep(2);
+
+        if (block >= 20 && block % 2 == 0)
+          gotMid |= processor->pullSpectrumFrame(mid.data(), scopeSize,
+                                                 View::mid);
+        else if (block >= 20)
+          gotSide |= processor->pullSpectrumFrame(side.data(), scopeSize,
+                                                  View::side);
+      }
+      processor->setSpectrumAnalyzerActive(false);
+      return gotMid && gotSide;
+    };
+
+    auto peakOf = [](const std::vector<float> &values) {
+      return *std::max_element(values.begin(), values.end());
+    };
+
+    // Identical channels: no side content, correlation close to +1
+    expect(analyse(1.0f), "Analyzer should publish stereo frames");
+    expect(peakOf(mid) > peakOf(side) + 0.3f,
+           "Mono signal should have a much quieter side spectrum");
+    expect(processor->getSpectrumCorrelation() > 0.9f,
+           "Identical channels should correlate near +1");
+
+    // Inverted right channel: no mid content, correlation close to -1
+    expect(analyse(-1.0f), "Analyzer should publish inverted frames");
+    expect(processor->getSpectrumCorrelation() < -0.9f,
+           "Inverted channels should correlate near -1");
+
+    // Left only: the left view carries the tone, the right view does not
+    processor->setSpectrumAnalyzerActive(true);
+    int phase = 0;
+    bool gotFrame = false;
+    for (int block = 0; block < 40; ++block) {
+      for (int sample = 0; sample < 512; ++sample, ++phase) {
+        buffer.setSample(0, sample,
+                         0.5f * std::sin(2.0f * 3.14159265f * 1000.0f * phase /
+                                         44100.0f));
+        buffer.setSample(1, sample, 0.0f);
+      }
+      processor->processBlock(buffer, midiBuffer);
+      juce::Thread::sleep(2);
+      if (block >= 20)
+        gotFrame |= processor->pullSpectrumFrame(left.data(), scopeSize,
+                                                 View::left);
+    }
+    processor->setSpectrumAnalyzerActive(false);
+
+    expect(gotFrame, "Analyzer should publish left-only frames");
+    expect(peakOf(left) > 0.5f, "Left view should show the left tone");
+  } catch (const std::exception &e) {
+    expect(false, std::string("Stereo analysis test threw exception: ") +
+                      e.what());
+  }
+}
+
+static void testInputOutputSpectrumTaps() {
+  beginTest("Input and Output Spectrum Taps");
+
+  try {
+    auto processor = std::make_unique<CustomReverbAudioProcessor>();
+    processor->prepareToPlay(44100.0, 512);
+
+    // Route everything through the reverb band and silence it, so the tone
+    // only reaches the input tap
+    auto &apvts = processor->getAPVTS();
+    apvts.getParameter("crossoverFreq")->setValueNotifyingHost(1.0f);
+    apvts.getParameter("wetLevel")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("dryLevel")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("highFreqMix")->setValueNotifyingHost(0.0f);
+    apvts.getParameter("harmDetuneAmount")->setValueNotifyingHost(0.0f);
+
+    const int scopeSize = CustomReverbAudioProcessor::scopeSize;
+    std::vector<float> output(scopeSize, 0.0f), input(scopeSize, 0.0f);
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midiBuffer;
+
+    processor->getSpectrumAnalyzerWorker().setInputTapEnabled(true);
+    processor->setSpectrumAnalyzerActive(true);
+
+    int phase = 0;
+    bool gotFrame = false;
+    for (int block = 0; block < 40; ++block) {
+      for (int sample = 0; sample < 512; ++sample, ++phase) {
+        const float tone =
+            0.5f * std::sin(2.0f * 3.14159265f * 1000.0f * phase / 44100.0f);
+        buffer.setSample(0, sample, tone);
+        buffer.setSample(1, sample, tone);
+      }
+      processor->processBlock(buffer, midiBuffer);
+      juce::Thread::sleep(2);
+
+      if (block >= 20)
+        gotFrame |= processor->pullSpectrumFrame(
+            output.data(), scopeSize, SpectrumAnalyzerWorker::View::mid,
+            input.data());
+    }
+    processor->setSpectrumAnalyzerActive(false);
+
+    const float inputPeak = *std::max_element(input.begin(), input.end());
+    const float outputPeak = *std::max_element(output.begin(), output.end());
+
+    expect(gotFrame, "Analyzer should publish frames with both taps");
+    expect(inputPeak > 0.5f, "Input tap should show the dry tone");
+    expect(inputPeak > outputPeak + 0.25f,
+           "Output tap should show the tone removed by the processing");
+  } catch (const std::exception &e) {
+    expect(false, std::string("Spectrum tap test threw exception: ") +
+                      e.what());
+  }
+}
+
+static void testSpectrumBinMap() {
+  beginTest("Log-Frequency Bin Map Aggregation");
+
+  const int fftSize = CustomReverbAudioProcessor::fftSize;
+  const int numBands = CustomReverbAudioProcessor::scopeSize;
+
+  SpectrumBinMap binMap;
+  binMap.build(44100.0, fftSize, numBands);
+
+  // Aggregating bands must tile the bin axis without gaps or overlaps
+  int expectedFirstBin = -1;
+  bool contiguous = true;
+  for (int band = 0; band < numBands; ++band) {
+    if (binMap.getNumBinsInBand(band) == 0)
+      continue;
+    if (expectedFirstBin >= 0)
+      contiguous &= binMap.getFirstBinOfBand(band) == expectedFirstBin;
+    expectedFirstBin =
+        binMap.getFirstBinOfBand(band) + binMap.getNumBinsInBand(band);
+  }
+  expect(contiguous, "Display bands should cover every bin exactly once");
+  expect(binMap.getNumBinsInBand(numBands - 1) > 1,
+         "Top bands should aggregate several bins");
+
+  // A single high-frequency bin must never fall between display points
+  std::vector<float> magnitudes((size_t)fftSize / 2, 0.0f);
+  std::vector<float> levels((size_t)numBands, 0.0f);
+  magnitudes[701] = static_cast<float>(fftSize);
+  binMap.process(magnitudes.data(), levels.data(),
+                 SpectrumBinMap::Aggregation::peak);
+  expectWithinError(*std::max_element(levels.begin(), levels.end()), 1.0f,
+                    0.001f, "Peak aggregation should keep a lone 15kHz bin");
+
+  binMap.process(magnitudes.data(), levels.data(),
+                 SpectrumBinMap::Aggregation::powerMean);
+  const float rmsLevel = *std::max_element(levels.begin(), levels.end());
+  expect(rmsLevel > 0.5f && rmsLevel < 1.0f,
+         "Power-mean should spread the bin's energy over its band");
+}
+
 //==============================================================================
 // Main Phase 2 Test Runner
 //==============================================================================
@@ -505,7 +1242,20 @@ int main() {
   testRefactoredParameterListeners();
   testBasicAudioProcessing();
   testParameterToAudioIntegration();
+  testBlockRateParameterUpdates();
+  testParameterSmoothing();
+  testConcurrentParameterSnapshots();
+  testPresetBank();
+  testMorphPad();
+  testMorphPadState();
   testProcessorStateManagement();
+  testLegacyXmlStateLoading();
+  testLazySpectrumAnalyzer();
+  testBackgroundSpectrumAnalysis();
+  testMultiResolutionSpectrum();
+  testStereoSpectrumViews();
+  testInputOutputSpectrumTaps();
+  testSpectrumBinMap();
 
   // Report results
   std::cout << "\n📊 Phase 2 Test Results:" << std::endl;
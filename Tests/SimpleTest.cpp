@@ -17,13 +17,24 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <complex>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
+// Real (JUCE-free) ReverbWave components
+#include "../Source/DspKernels.h"
+#include "../Source/ParameterState.h"
+#include "../Source/ParticlePool.h"
+#include "../Source/WavePhysics.h"
+#include "../Source/SpectrumAnalyzer.h"
+#include "../Source/TerminalRenderer.h"
+#include "../Source/TripleBuffer.h"
+
 //==============================================================================
 // Test framework
 //==============================================================================
@@ -281,6 +292,542 @@ void testRefactoringBenefits() {
       "Refactored helper methods provide consistent behavior across instances");
 }
 
+void testTripleBufferHandOff() {
+  beginTest("Triple Buffer Snapshot Hand-off");
+
+  struct Frame {
+    std::uint64_t values[64];
+  };
+
+  TripleBuffer<Frame> frames;
+  expect(!frames.fetch(), "Nothing should be fetched before a publish");
+  expect(frames.getReadSequence() == 0, "Initial read sequence should be 0");
+
+  // Consumer always gets the newest snapshot, older ones are skipped
+  for (std::uint64_t n = 1; n <= 3; ++n) {
+    std::fill(std::begin(frames.getWriteBuffer().values),
+              std::end(frames.getWriteBuffer().values), n);
+    frames.publish();
+  }
+
+  expect(frames.fetch(), "A published snapshot should be fetched");
+  expect(frames.getReadBuffer().values[0] == 3,
+         "Fetch should return the latest snapshot");
+  expect(frames.getReadSequence() == 3, "Sequence should count publishes");
+  expect(!frames.fetch(), "The same snapshot should not be fetched twice");
+
+  // Concurrent producer/consumer: frames must never be torn and sequence
+  // numbers must only move forwards
+  const std::uint64_t numFrames = 20000;
+  bool torn = false, backwards = false;
+
+  std::thread producer([&frames, numFrames] {
+    for (std::uint64_t n = 4; n < 4 + numFrames; ++n) {
+      auto &frame = frames.getWriteBuffer();
+      std::fill(std::begin(frame.values), std::end(frame.values), n);
+      frames.publish();
+    }
+  });
+
+  std::uint64_t lastSequence = frames.getReadSequence();
+  while (lastSequence < 3 + numFrames) {
+    if (!frames.fetch())
+      continue;
+
+    const auto &frame = frames.getReadBuffer();
+    for (auto value : frame.values)
+      torn |= value != frame.values[0];
+
+    backwards |= frames.getReadSequence() <= lastSequence;
+    lastSequence = frames.getReadSequence();
+  }
+
+  producer.join();
+
+  expect(!torn, "Concurrently fetched snapshots should never be torn");
+  expect(!backwards, "Sequence numbers should increase monotonically");
+  expect(lastSequence == 3 + numFrames,
+         "Consumer should end on the final published snapshot");
+}
+
+void testRealInputFFT() {
+  beginTest("Real-Input FFT Against Reference DFT");
+
+  const int order = 8;
+  const int size = 1 << order;
+  FFT fft(order);
+
+  std::vector<float> input(size);
+  for (int i = 0; i < size; ++i)
+    input[i] = std::sin(0.37f * i) + 0.25f * std::cos(1.9f * i) +
+               0.1f * static_cast<float>((i * 7919) % 13) - 0.6f;
+
+  // Direct DFT reference in double precision
+  std::vector<std::complex<double>> reference(size / 2 + 1);
+  for (int k = 0; k <= size / 2; ++k)
+    for (int n = 0; n < size; ++n)
+      reference[k] += std::polar(1.0, -2.0 * M_PI * k * n / size) *
+                      static_cast<double>(input[n]);
+
+  std::vector<std::complex<float>> realOutput(size / 2 + 1);
+  fft.performRealForward(input.data(), realOutput.data());
+
+  std::vector<std::complex<float>> complexData(input.begin(), input.end());
+  fft.perform(complexData.data());
+
+  double realError = 0.0, complexError = 0.0;
+  for (int k = 0; k <= size / 2; ++k) {
+    realError = std::max(
+        realError,
+        std::abs(std::complex<double>(realOutput[k]) - reference[k]));
+    complexError = std::max(
+        complexError,
+        std::abs(std::complex<double>(complexData[k]) - reference[k]));
+  }
+
+  expect(realError < 1.0e-3, "Real FFT should match the reference DFT");
+  expect(complexError < 1.0e-3, "Complex FFT should match the reference DFT");
+
+  // Bin-centred sine: Hann coherent gain halves the normalised amplitude
+  const int toneBin = 20;
+  for (int i = 0; i < size; ++i)
+    input[i] = 0.8f * std::sin(2.0f * static_cast<float>(M_PI) * toneBin * i /
+                               size);
+
+  std::vector<float> magnitudes(size / 2);
+  fft.calculateMagnitudeSpectrum(input.data(), magnitudes.data(), size);
+
+  const auto peak = std::max_element(magnitudes.begin(), magnitudes.end());
+  expect(peak - magnitudes.begin() == toneBin,
+         "Magnitude spectrum should peak at the tone's bin");
+  expect(std::abs(*peak - 0.4f) < 0.01f,
+         "Windowed peak magnitude should be half the tone amplitude");
+
+  // Repeated frames must give identical results (no state leaks between
+  // calls through the preallocated scratch)
+  std::vector<float> again(size / 2);
+  fft.calculateMagnitudeSpectrum(input.data(), again.data(), size);
+  expect(std::equal(again.begin(), again.end(), magnitudes.begin()),
+         "Consecutive frames should produce identical spectra");
+
+  // Shorter input is windowed over its own length and zero padded
+  fft.calculateMagnitudeSpectrum(input.data(), again.data(), size / 2);
+  expect(std::abs(again[toneBin] - 0.2f) < 0.01f,
+         "Zero padded half-length frame should keep the tone's bin");
+}
+
+void testDspKernelVariants() {
+  beginTest("SIMD Kernel Variants Match Scalar Reference");
+
+  using DspKernels::InstructionSet;
+  const auto &scalar = DspKernels::getKernels(InstructionSet::scalar);
+
+  expect(scalar.instructionSet == InstructionSet::scalar,
+         "Scalar kernels should always be available");
+  expect(DspKernels::isSupported(DspKernels::detectInstructionSet()),
+         "Detected instruction set should be supported by this CPU");
+
+  // Odd length so every variant also runs its scalar tail
+  const int numSamples = 1037;
+  std::vector<float> input(numSamples), other(numSamples);
+  for (int i = 0; i < numSamples; ++i) {
+    input[i] = std::sin(0.05f * i) + 0.3f * std::sin(1.3f * i);
+    other[i] = std::cos(0.21f * i);
+  }
+
+  auto maxDifference = [](const std::vector<float> &a,
+                          const std::vector<float> &b) {
+    float difference = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i)
+      difference = std::max(difference, std::abs(a[i] - b[i]));
+    return difference;
+  };
+
+  // Reference results
+  std::vector<float> refLow(numSamples), refHigh(numSamples);
+  float refState = 0.25f;
+  scalar.splitOnePole(input.data(), refLow.data(), refHigh.data(), numSamples,
+                      0.13f, refState);
+
+  std::vector<float> refSum(numSamples);
+  scalar.add(refSum.data(), input.data(), other.data(), numSamples);
+
+  // A mix ramp from 0.2 to 0.9 across the block
+  const float rampStep = 0.7f / numSamples;
+  std::vector<float> refRamp(numSamples);
+  scalar.crossfadeRamp(refRamp.data(), input.data(), other.data(), 0.2f,
+                       rampStep, numSamples);
+  std::vector<float> constantRamp(numSamples), fixedMix(numSamples);
+  scalar.crossfadeRamp(constantRamp.data(), input.data(), other.data(), 0.3f,
+                       0.0f, numSamples);
+  for (int i = 0; i < numSamples; ++i)
+    fixedMix[i] = input[i] * 0.7f + other[i] * 0.3f;
+  expect(maxDifference(constantRamp, fixedMix) < 1.0e-6f,
+         "A flat crossfade ramp should equal a fixed gain mix");
+
+  const int fftSize = 256;
+  std::vector<float> twiddleRe(fftSize), twiddleIm(fftSize);
+  for (int j = 0; j < fftSize; ++j) {
+    twiddleRe[j] = std::cos(-2.0f * static_cast<float>(M_PI) * j / fftSize);
+    twiddleIm[j] = std::sin(-2.0f * static_cast<float>(M_PI) * j / fftSize);
+  }
+
+  auto runStages = [&](const DspKernels::KernelTable &kernels,
+                       std::vector<float> &re, std::vector<float> &im) {
+    re.assign(input.begin(), input.begin() + fftSize);
+    im.assign(other.begin(), other.begin() + fftSize);
+    for (int halfSpan = 1; halfSpan < fftSize; halfSpan *= 2)
+      kernels.fftButterflyStage(re.data(), im.data(), twiddleRe.data(),
+                                twiddleIm.data(), fftSize, halfSpan);
+  };
+
+  std::vector<float> refRe, refIm;
+  runStages(scalar, refRe, refIm);
+
+  // Bar rows: a staircase of bar tops crossing the tested row
+  const int barWidth = 203;
+  const int barRow = 40;
+  std::vector<std::int32_t> tops(barWidth);
+  std::vector<std::uint32_t> body(barWidth), highlight(barWidth);
+  for (int x = 0; x < barWidth; ++x) {
+    tops[x] = (x * 7) % 80;
+    body[x] = 0xff000000u | (std::uint32_t)x;
+    highlight[x] = 0xffff0000u | (std::uint32_t)x;
+  }
+  std::vector<std::uint32_t> refBarRow(barWidth);
+  scalar.fillBarRow(refBarRow.data(), tops.data(), body.data(),
+                    highlight.data(), barRow, 2, barWidth);
+
+  // Particles: a few integration steps over an odd-sized pool
+  const int numParticles = 77;
+  auto runParticles = [&](const DspKernels::KernelTable &kernels,
+                          std::vector<float> &x, std::vector<float> &life) {
+    x.assign(input.begin(), input.begin() + numParticles);
+    std::vector<float> y(other.begin(), other.begin() + numParticles);
+    std::vector<float> vx(numParticles, 0.3f), vy(numParticles, -0.2f);
+    life.assign(numParticles, 1.0f);
+    for (int step = 0; step < 10; ++step)
+      kernels.integrateParticles(x.data(), y.data(), vx.data(), vy.data(),
+                                 life.data(), numParticles, 1.0f / 60.0f,
+                                 0.6f, 0.98f);
+    for (int i = 0; i < numParticles; ++i)
+      x[i] += y[i] * 1000.0f; // Fold y into the compared values
+  };
+  std::vector<float> refParticleX, refParticleLife;
+  runParticles(scalar, refParticleX, refParticleLife);
+
+  // Wave: odd length so every variant runs its scalar tails
+  const int numWavePoints = 131;
+  auto runWave = [&](const DspKernels::KernelTable &kernels,
+                     std::vector<float> &points) {
+    points.assign(numWavePoints, 0.0f);
+    std::vector<float> velocities(numWavePoints, 0.0f);
+    for (int step = 0; step < 20; ++step)
+      kernels.waveSpringStep(points.data(), velocities.data(), input.data(),
+                             numWavePoints, 0.025f, 0.97f, 0.05f, 0.2f);
+    for (int i = 0; i < numWavePoints; ++i)
+      points[i] += velocities[i] * 1000.0f; // Fold velocities in as well
+  };
+  std::vector<float> refWave;
+  runWave(scalar, refWave);
+
+  for (auto set : {InstructionSet::sse2, InstructionSet::avx2,
+                   InstructionSet::avx512}) {
+    if (!DspKernels::isSupported(set))
+      continue;
+
+    const auto &kernels = DspKernels::getKernels(set);
+    const std::string name = kernels.name;
+    expect(kernels.instructionSet == set,
+           name + " table should be returned when supported");
+
+    // In place, as processBlock uses it (high band overwrites the input)
+    std::vector<float> low(numSamples), high(input);
+    float state = 0.25f;
+    kernels.splitOnePole(high.data(), low.data(), high.data(), numSamples,
+                         0.13f, state);
+    expect(maxDifference(low, refLow) < 1.0e-5f &&
+               maxDifference(high, refHigh) < 1.0e-5f &&
+               std::abs(state - refState) < 1.0e-5f,
+           name + " crossover should match scalar");
+
+    std::vector<float> ramp(input);
+    kernels.crossfadeRamp(ramp.data(), ramp.data(), other.data(), 0.2f,
+                          rampStep, numSamples);
+    expect(maxDifference(ramp, refRamp) < 1.0e-5f,
+           name + " crossfade ramp should match scalar");
+
+    std::vector<float> sum(numSamples);
+    kernels.add(sum.data(), input.data(), other.data(), numSamples);
+    expect(maxDifference(sum, refSum) == 0.0f,
+           name + " add should match scalar exactly");
+
+    std::vector<float> re, im;
+    runStages(kernels, re, im);
+    expect(maxDifference(re, refRe) < 1.0e-4f &&
+               maxDifference(im, refIm) < 1.0e-4f,
+           name + " FFT butterflies should match scalar");
+
+    std::vector<std::uint32_t> barRowPixels(barWidth);
+    kernels.fillBarRow(barRowPixels.data(), tops.data(), body.data(),
+                       highlight.data(), barRow, 2, barWidth);
+    expect(barRowPixels == refBarRow,
+           name + " bar row fill should match scalar exactly");
+
+    std::vector<float> particleX, particleLife;
+    runParticles(kernels, particleX, particleLife);
+    expect(maxDifference(particleX, refParticleX) < 1.0e-3f &&
+               maxDifference(particleLife, refParticleLife) < 1.0e-6f,
+           name + " particle integration should match scalar");
+
+    std::vector<float> wave;
+    runWave(kernels, wave);
+    expect(maxDifference(wave, refWave) < 1.0e-3f,
+           name + " wave spring step should match scalar");
+  }
+}
+
+void testParticlePool() {
+  beginTest("Fixed-Capacity Particle Pool");
+
+  ParticlePool pool(64);
+  XorShiftRandom random(1234);
+
+  // Spawning stops at the capacity, however much is requested
+  int numSpawned = 0;
+  for (int i = 0; i < 200; ++i)
+    numSpawned += pool.spawn(random.nextFloat(), random.nextFloat(), 0.0f,
+                             0.0f, 0.1f + random.nextFloat(),
+                             (std::uint16_t)i) ? 1 : 0;
+  expect(numSpawned == 64 && pool.size() == 64 && pool.isFull(),
+         "Pool should accept exactly its capacity");
+
+  // Particles die when their life runs out and the survivors stay packed
+  pool.step(0.5f, 0.0f, 1.0f);
+  bool allAlive = true;
+  for (int i = 0; i < pool.size(); ++i)
+    allAlive &= pool.getLife()[i] > 0.0f;
+  expect(pool.size() > 0 && pool.size() < 64 && allAlive,
+         "Step should remove exactly the expired particles");
+
+  for (int i = 0; i < 4; ++i)
+    pool.step(0.5f, 0.0f, 1.0f);
+  expect(pool.size() == 0, "All particles should expire eventually");
+
+  // Motion follows velocity and gravity
+  pool.spawn(0.0f, 0.0f, 1.0f, 0.0f, 10.0f, 0);
+  pool.step(0.1f, 2.0f, 1.0f);
+  expect(std::abs(pool.getX()[0] - 0.1f) < 1.0e-6f &&
+             std::abs(pool.getY()[0] - 0.02f) < 1.0e-6f,
+         "Particles should move by velocity and gravity");
+
+  // The generator is deterministic and stays in [0, 1)
+  XorShiftRandom a(42), b(42);
+  bool same = true, inRange = true;
+  for (int i = 0; i < 1000; ++i) {
+    const float value = a.nextFloat();
+    same &= value == b.nextFloat();
+    inRange &= value >= 0.0f && value < 1.0f;
+  }
+  expect(same && inRange, "XorShift should be deterministic and in [0, 1)");
+}
+
+void testWavePhysics() {
+  beginTest("Fixed-Timestep Wave Physics");
+
+  const int numPoints = 64;
+  std::vector<float> targets(numPoints);
+  for (int i = 0; i < numPoints; ++i)
+    targets[i] = 0.5f + 0.4f * std::sin(0.3f * (float)i);
+
+  // The same wall-clock time gives the same motion at any refresh rate
+  WavePhysics at144(numPoints), at60(numPoints), at30(numPoints);
+  int steps144 = 0, steps60 = 0, steps30 = 0;
+  for (int frame = 0; frame < 144; ++frame)
+    steps144 += at144.advance(targets.data(), 1.0 / 144.0);
+  for (int frame = 0; frame < 60; ++frame)
+    steps60 += at60.advance(targets.data(), 1.0 / 60.0);
+  for (int frame = 0; frame < 30; ++frame)
+    steps30 += at30.advance(targets.data(), 1.0 / 30.0);
+  expect(std::abs(steps144 - 60) <= 1 && std::abs(steps60 - 60) <= 1 &&
+             std::abs(steps30 - 60) <= 1,
+         "One second should take 60 steps at any call rate");
+
+  // Steps match the original per-frame solver (spread forces gathered in a
+  // separate buffer)
+  WavePhysics physics(numPoints);
+  std::vector<float> points(numPoints, 0.0f), velocities(numPoints, 0.0f);
+  const auto settings = physics.getSettings();
+  for (int step = 0; step < 30; ++step) {
+    physics.step(targets.data());
+
+    for (int i = 0; i < numPoints; ++i) {
+      velocities[i] += settings.tension * (targets[i] - points[i]);
+      points[i] += velocities[i] * settings.speed;
+      velocities[i] *= settings.damping;
+    }
+    std::vector<float> spreadForces(numPoints, 0.0f);
+    for (int i = 1; i < numPoints - 1; ++i)
+      spreadForces[i] = settings.spreadFactor *
+                        ((points[i - 1] - points[i]) +
+                         (points[i + 1] - points[i]));
+    for (int i = 1; i < numPoints - 1; ++i)
+      velocities[i] += spreadForces[i];
+  }
+  float maxError = 0.0f;
+  for (int i = 0; i < numPoints; ++i)
+    maxError =
+        std::max(maxError, std::abs(points[i] - physics.getPoints()[i]));
+  expect(maxError < 1.0e-4f, "Solver should match the original algorithm");
+
+  // A stall is capped instead of replayed
+  WavePhysics stalled(numPoints);
+  expect(stalled.advance(targets.data(), 5.0) ==
+                 WavePhysics::maxStepsPerAdvance &&
+             stalled.advance(targets.data(), 0.0) == 0,
+         "A long gap should take at most maxStepsPerAdvance steps");
+
+  // The wave comes to rest on a flat target
+  const std::vector<float> flat(numPoints, 0.5f);
+  for (int step = 0; step < 3000; ++step)
+    stalled.step(flat.data());
+  expect(stalled.isSettled(flat.data(), 1.0e-3f),
+         "Wave should settle on constant targets");
+
+  stalled.reset();
+  expect(stalled.getPoints()[numPoints / 2] == 0.0f &&
+             !stalled.isSettled(flat.data(), 1.0e-3f),
+         "Reset should put every point back at zero");
+}
+
+void testTerminalRenderer() {
+  beginTest("Diff-Based Terminal Renderer");
+
+  TerminalRenderer terminal(20, 5);
+
+  // The first frame clears the screen and prints only non-blank cells
+  terminal.clear();
+  terminal.setCell(0, 0, 'a');
+  terminal.setCell(3, 2, 'b');
+  terminal.setCell(25, 2, 'x'); // Outside: ignored
+  expect(terminal.update() == "\x1b[H\x1b[2Ja\x1b[3;4Hb",
+         "First frame should clear the screen and print only content");
+
+  // An unchanged frame sends nothing
+  expect(terminal.update().empty(), "Unchanged frame should send no bytes");
+
+  // One changed cell: one cursor move and one character
+  terminal.setCell(10, 4, 'c');
+  expect(terminal.update() == "\x1b[5;11Hc",
+         "A single change should cost one cursor move");
+
+  // Nearby changes on a row rewrite the short gap instead of jumping
+  terminal.setCell(12, 1, 'd');
+  terminal.setCell(15, 1, 'e');
+  expect(terminal.update() == "\x1b[2;13Hd  e",
+         "Short gaps should be rewritten rather than skipped");
+
+  // Redrawing the same spectrum frame after a clear sends nothing
+  SpectrumAnalyzer analyzer;
+  TerminalRenderer screen(60, 16);
+  analyzer.draw(screen);
+  const std::size_t firstFrameBytes = screen.update().size();
+  analyzer.draw(screen);
+  expect(firstFrameBytes > 0 && screen.update().empty() &&
+             screen.getCell(0, 0) == '+',
+         "Redrawing an unchanged analyzer should send nothing");
+
+  // invalidate() forces a full redraw
+  screen.invalidate();
+  expect(screen.update().size() == firstFrameBytes,
+         "Invalidate should repeat the full first frame");
+}
+
+void testParameterStateFormat() {
+  beginTest("Binary Parameter State Chunk");
+
+  const char *ids[] = {"roomSize", "damping", "wetLevel", "crossoverFreq"};
+  std::uint32_t hashes[4];
+  for (int i = 0; i < 4; ++i)
+    hashes[i] = ParameterState::hashParameterID(ids[i]);
+  expect(std::set<std::uint32_t>(hashes, hashes + 4).size() == 4,
+         "Parameter ID hashes should be distinct");
+
+  // Header fields are little-endian at fixed offsets
+  const float saved[] = {0.7f, 0.25f, 0.0f, 1234.5f};
+  ParameterState::MorphPadState morphPad;
+  morphPad.enabled = true;
+  morphPad.x = 0.25f;
+  morphPad.y = 0.75f;
+  const std::uint8_t corners[] = {3, 5, 3, 7};
+  std::copy_n(corners, 4, morphPad.cornerPresets);
+  std::vector<unsigned char> chunk(ParameterState::getEncodedSize(4));
+  ParameterState::encode(hashes, saved, 4, morphPad, chunk.data());
+  const std::string magic(chunk.begin(), chunk.begin() + 4);
+  expect(chunk.size() == 56 && magic == "RVWS" &&
+             chunk[4] == ParameterState::currentVersion && chunk[6] == 4,
+         "Chunk should start with magic, version and entry count");
+
+  // Round trip, matched by hash regardless of order
+  const std::uint32_t reordered[] = {hashes[3], hashes[0], hashes[2],
+                                     hashes[1]};
+  float loaded[4] = {};
+  bool found[4] = {};
+  expect(ParameterState::decode(chunk.data(), chunk.size(), reordered, 4,
+                                loaded, found) == 4 &&
+             loaded[0] == 1234.5f && loaded[1] == 0.7f && loaded[3] == 0.25f,
+         "Values should round-trip bit-exactly by parameter ID");
+
+  // Parameters unknown to the chunk keep their value; unknown entries are
+  // skipped
+  const std::uint32_t partial[] = {hashes[1],
+                                   ParameterState::hashParameterID("newParam")};
+  float partialValues[2] = {-1.0f, -1.0f};
+  bool partialFound[2] = {};
+  expect(ParameterState::decode(chunk.data(), chunk.size(), partial, 2,
+                                partialValues, partialFound) == 1 &&
+             partialValues[0] == 0.25f && partialValues[1] == -1.0f &&
+             !partialFound[1],
+         "Missing parameters should keep their current value");
+
+  // The morph pad follows the parameters
+  ParameterState::MorphPadState loadedPad;
+  expect(ParameterState::decodeMorphPad(chunk.data(), chunk.size(),
+                                        loadedPad) &&
+             loadedPad.enabled && loadedPad.x == 0.25f &&
+             loadedPad.y == 0.75f &&
+             std::equal(corners, corners + 4, loadedPad.cornerPresets),
+         "Morph pad settings should round-trip");
+
+  // Version 1 chunks end after the parameters and have no morph pad
+  std::vector<unsigned char> versionOne(chunk.begin(), chunk.end() - 16);
+  versionOne[4] = 1;
+  float versionOneValues[4] = {};
+  bool versionOneFound[4] = {};
+  ParameterState::MorphPadState untouchedPad;
+  expect(ParameterState::decode(versionOne.data(), versionOne.size(), hashes,
+                                4, versionOneValues, versionOneFound) == 4 &&
+             versionOneValues[3] == 1234.5f &&
+             !ParameterState::decodeMorphPad(versionOne.data(),
+                                             versionOne.size(), untouchedPad) &&
+             !untouchedPad.enabled,
+         "Version 1 chunks should still load, without a morph pad");
+
+  // Anything else is left to the XML fallback
+  const std::string xml = "<?xml version=\"1.0\"?><Parameters/>";
+  expect(!ParameterState::isBinaryState(xml.data(), xml.size()) &&
+             ParameterState::decode(chunk.data(), chunk.size() - 1, hashes, 4,
+                                    loaded, found) == -1 &&
+             !ParameterState::decodeMorphPad(chunk.data(), chunk.size() - 1,
+                                             loadedPad),
+         "XML and truncated chunks should be rejected");
+
+  chunk[4] = ParameterState::currentVersion + 1;
+  expect(ParameterState::decode(chunk.data(), chunk.size(), hashes, 4, loaded,
+                                found) == -1,
+         "Chunks from a newer format version should be rejected");
+}
+
 //==============================================================================
 // Main test runner
 //==============================================================================
@@ -298,6 +845,13 @@ int main() {
   testStereoProcessing();
   testCircularBufferOperations();
   testRefactoringBenefits();
+  testTripleBufferHandOff();
+  testRealInputFFT();
+  testDspKernelVariants();
+  testParticlePool();
+  testWavePhysics();
+  testTerminalRenderer();
+  testParameterStateFormat();
 
   // Report results
   std::cout << "\n📊 Test Results:" << std::endl;